@@ -0,0 +1,832 @@
+#ifndef AISDI_MAPS_BPLUSTREEMAP_H
+#define AISDI_MAPS_BPLUSTREEMAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace aisdi
+{
+
+// Mapa uporzadkowana jak TreeMap, ale na B+drzewie: wezly trzymaja po kilkadziesiat
+// kluczy w ciaglej tablicy (kilka linii pamieci podrecznej), pary sa tylko w lisciach,
+// a liscie polaczone sa w liste, wiec przejscie in-order to sekwencyjne czytanie.
+// Klucz musi miec konstruktor domyslny i przypisanie - kopie kluczy siedza w wezlach.
+template <typename KeyType, typename ValueType>
+class BPlusTreeMap
+{
+public:
+  using key_type = KeyType;
+  using mapped_type = ValueType;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  // okolo 256 bajtow kluczy na wezel, parzyscie, zeby podzial dawal rowne polowy
+  static const size_type NODE_KEYS = (256 / sizeof(key_type) < 8 ? 8 :
+                                      256 / sizeof(key_type) > 64 ? 64 : 256 / sizeof(key_type)) & ~size_type(1);
+
+private:
+  using Slot = typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type;
+
+  static const size_type MIN_KEYS = NODE_KEYS / 2;
+  static const size_type MAX_HEIGHT = 32;
+
+  class Node
+  {
+  public:
+      bool leaf;
+      size_type count;
+
+      explicit Node(bool leaf): leaf(leaf), count(0){}
+  };
+
+  // jeden dodatkowy slot pozwala najpierw wstawic, a potem podzielic przepelniony wezel
+  class Inner : public Node
+  {
+  public:
+      key_type keys[NODE_KEYS + 1];
+      Node* children[NODE_KEYS + 2];
+
+      Inner(): Node(false){}
+  };
+
+  class Leaf : public Node
+  {
+  public:
+      key_type keys[NODE_KEYS + 1];
+      Slot slots[NODE_KEYS + 1];
+      Leaf* next;
+      Leaf* prev;
+
+      Leaf(): Node(true), next(nullptr), prev(nullptr){}
+
+      value_type& slot(size_type index)
+      {
+          return *reinterpret_cast<value_type*>(&slots[index]);
+      }
+
+      const value_type& slot(size_type index) const
+      {
+          return *reinterpret_cast<const value_type*>(&slots[index]);
+      }
+  };
+
+  class PathEntry
+  {
+  public:
+      Inner* node;
+      size_type index;//numer dziecka, do ktorego zeszlismy
+  };
+
+  Node* root;
+  Leaf* first_leaf;
+  Leaf* last_leaf;
+  size_type counter;
+
+public:
+
+  BPlusTreeMap(): root(nullptr), first_leaf(nullptr), last_leaf(nullptr), counter(0)
+  {}
+
+  BPlusTreeMap(std::initializer_list<value_type> list):BPlusTreeMap()
+  {
+        for(auto it = list.begin(); it!= list.end(); it++)
+            operator[]((*it).first) = (*it).second;
+  }
+
+  BPlusTreeMap(const BPlusTreeMap& other):BPlusTreeMap()
+  {
+        if(other.root == nullptr)
+            return;
+        Leaf* previous = nullptr;
+        root = copyNode(other.root, previous);
+        last_leaf = previous;
+        counter = other.counter;
+  }
+
+  BPlusTreeMap(BPlusTreeMap&& other) noexcept:
+      root(other.root), first_leaf(other.first_leaf), last_leaf(other.last_leaf), counter(other.counter)
+  {
+        other.root = nullptr;
+        other.first_leaf = nullptr;
+        other.last_leaf = nullptr;
+        other.counter = 0;
+  }
+
+  BPlusTreeMap& operator=(const BPlusTreeMap& other)
+  {
+        if(this != &other)
+        {
+            BPlusTreeMap temp(other);
+            swap(temp);
+        }
+        return *this;
+  }
+
+  BPlusTreeMap& operator=(BPlusTreeMap&& other) noexcept
+  {
+        if(this != &other)
+        {
+            BPlusTreeMap temp(std::move(other));
+            swap(temp);
+        }
+        return *this;
+  }
+
+  ~BPlusTreeMap()
+  {
+        if(root != nullptr)
+            destroyNode(root);
+  }
+
+  void swap(BPlusTreeMap& other) noexcept
+  {
+        std::swap(root, other.root);
+        std::swap(first_leaf, other.first_leaf);
+        std::swap(last_leaf, other.last_leaf);
+        std::swap(counter, other.counter);
+  }
+
+  bool isEmpty() const
+  {
+        return counter == 0;
+  }
+
+  mapped_type& operator[](const key_type& key)
+  {
+        if(root == nullptr)
+        {
+            first_leaf = last_leaf = createLeaf();
+            root = first_leaf;
+        }
+
+        PathEntry path[MAX_HEIGHT];
+        size_type depth = 0;
+        Leaf* leaf = descend(key, path, depth);
+        size_type index = lowerIndex(leaf->keys, leaf->count, key);
+        if(index < leaf->count && !(key < leaf->keys[index]))
+            return leaf->slot(index).second;
+
+        openGap(leaf, index);
+        new (&leaf->slots[index]) value_type(key, mapped_type());
+        leaf->keys[index] = key;
+        leaf->count++;
+        counter++;
+
+        if(leaf->count <= NODE_KEYS)
+            return leaf->slot(index).second;
+
+        Leaf* right = splitLeaf(leaf);
+        insertIntoParent(path, depth, leaf, right->keys[0], right);
+        if(index >= leaf->count)
+            return right->slot(index - leaf->count).second;
+        return leaf->slot(index).second;
+  }
+
+  const mapped_type& valueOf(const key_type& key) const
+  {
+        const_iterator it = find(key);
+        if(it == end())
+            throw std::out_of_range("valueOf out of range error");
+        return it->second;
+  }
+
+  mapped_type& valueOf(const key_type& key)
+  {
+        iterator it = find(key);
+        if(it == end())
+            throw std::out_of_range("valueOf out of range error");
+        return it->second;
+  }
+
+  const_iterator find(const key_type& key) const
+  {
+        const Leaf* leaf = findLeaf(key);
+        if(leaf == nullptr)
+            return cend();
+        const size_type index = lowerIndex(leaf->keys, leaf->count, key);
+        if(index == leaf->count || key < leaf->keys[index])
+            return cend();
+        return const_iterator(this, leaf, index);
+  }
+
+  iterator find(const key_type& key)
+  {
+        return iterator(static_cast<const BPlusTreeMap*>(this)->find(key));
+  }
+
+  void remove(const key_type& key)
+  {
+        if(root == nullptr)
+            throw std::out_of_range("remove out of range");
+
+        PathEntry path[MAX_HEIGHT];
+        size_type depth = 0;
+        Leaf* leaf = descend(key, path, depth);
+        const size_type index = lowerIndex(leaf->keys, leaf->count, key);
+        if(index == leaf->count || key < leaf->keys[index])
+            throw std::out_of_range("remove out of range");
+
+        leaf->slot(index).~value_type();
+        closeGap(leaf, index);
+        counter--;
+        rebalanceLeaf(leaf, path, depth);
+  }
+
+  void remove(const const_iterator& it)
+  {
+        if(it.map != this || it.leaf == nullptr)
+            throw std::out_of_range("remove out of range");
+        const key_type key = it.leaf->keys[it.index];//klucz w lisciu przesunie sie podczas usuwania
+        remove(key);
+  }
+
+  size_type getSize() const
+  {
+        return counter;
+  }
+
+  // liczba poziomow; wszystkie liscie leza na tej samej glebokosci
+  size_type height() const
+  {
+        size_type levels = 0;
+        for(const Node* node = root; node != nullptr; levels++)
+            node = node->leaf ? nullptr : static_cast<const Inner*>(node)->children[0];
+        return levels;
+  }
+
+  bool operator==(const BPlusTreeMap& other) const
+  {
+        if(other.counter != counter)
+            return false;
+
+        // obie mapy sa uporzadkowane, wiec wystarczy jedno wspolne przejscie
+        for(auto it = begin(), otherIt = other.begin(); it != end(); ++it, ++otherIt)
+            if(it->first < otherIt->first || otherIt->first < it->first || !(it->second == otherIt->second))
+                return false;
+        return true;
+  }
+
+  bool operator!=(const BPlusTreeMap& other) const
+  {
+        return !(*this == other);
+  }
+
+  iterator begin()
+  {
+        return iterator(cbegin());
+  }
+
+  iterator end()
+  {
+        return iterator(cend());
+  }
+
+  const_iterator cbegin() const
+  {
+        return const_iterator(this, first_leaf, 0);
+  }
+
+  const_iterator cend() const
+  {
+        return const_iterator(this, nullptr, 0);
+  }
+
+  const_iterator begin() const
+  {
+        return cbegin();
+  }
+
+  const_iterator end() const
+  {
+        return cend();
+  }
+
+private:
+
+  // pierwszy indeks z keys[i] >= key; petla bez skokow warunkowych (kompilator uzywa cmov)
+  static size_type lowerIndex(const key_type* keys, size_type count, const key_type& key)
+  {
+        if(count == 0)
+            return 0;
+        const key_type* base = keys;
+        while(count > 1)
+        {
+            const size_type half = count / 2;
+            base = (base[half - 1] < key) ? base + half : base;
+            count -= half;
+        }
+        return static_cast<size_type>(base - keys) + (*base < key);
+  }
+
+  // pierwszy indeks z keys[i] > key - numer dziecka wezla wewnetrznego
+  static size_type upperIndex(const key_type* keys, size_type count, const key_type& key)
+  {
+        if(count == 0)
+            return 0;
+        const key_type* base = keys;
+        while(count > 1)
+        {
+            const size_type half = count / 2;
+            base = (key < base[half - 1]) ? base : base + half;
+            count -= half;
+        }
+        return static_cast<size_type>(base - keys) + !(key < *base);
+  }
+
+  static Inner* asInner(Node* node)
+  {
+        return static_cast<Inner*>(node);
+  }
+
+  static Leaf* asLeaf(Node* node)
+  {
+        return static_cast<Leaf*>(node);
+  }
+
+  const Leaf* findLeaf(const key_type& key) const
+  {
+        const Node* node = root;
+        if(node == nullptr)
+            return nullptr;
+        while(!node->leaf)
+        {
+            const Inner* inner = static_cast<const Inner*>(node);
+            node = inner->children[upperIndex(inner->keys, inner->count, key)];
+        }
+        return static_cast<const Leaf*>(node);
+  }
+
+  Leaf* descend(const key_type& key, PathEntry* path, size_type& depth)
+  {
+        Node* node = root;
+        depth = 0;
+        while(!node->leaf)
+        {
+            Inner* inner = asInner(node);
+            const size_type index = upperIndex(inner->keys, inner->count, key);
+            path[depth].node = inner;
+            path[depth].index = index;
+            depth++;
+            node = inner->children[index];
+        }
+        return asLeaf(node);
+  }
+
+  Leaf* createLeaf()
+  {
+        return new Leaf();
+  }
+
+  Inner* createInner()
+  {
+        return new Inner();
+  }
+
+  void destroyNode(Node* node)
+  {
+        if(node->leaf)
+        {
+            Leaf* leaf = asLeaf(node);
+            for(size_type i = 0; i < leaf->count; i++)
+                leaf->slot(i).~value_type();
+            delete leaf;
+            return;
+        }
+        Inner* inner = asInner(node);
+        for(size_type i = 0; i <= inner->count; i++)
+            destroyNode(inner->children[i]);
+        delete inner;
+  }
+
+  // liscie kopiowane sa w kolejnosci in-order, wiec od razu mozna je polaczyc
+  Node* copyNode(const Node* node, Leaf*& previous)
+  {
+        if(node->leaf)
+        {
+            const Leaf* source = static_cast<const Leaf*>(node);
+            Leaf* leaf = createLeaf();
+            for(size_type i = 0; i < source->count; i++)
+            {
+                new (&leaf->slots[i]) value_type(source->slot(i));
+                leaf->keys[i] = source->keys[i];
+                leaf->count++;
+            }
+            leaf->prev = previous;
+            if(previous != nullptr)
+                previous->next = leaf;
+            else
+                first_leaf = leaf;
+            previous = leaf;
+            return leaf;
+        }
+
+        const Inner* source = static_cast<const Inner*>(node);
+        Inner* inner = createInner();
+        for(size_type i = 0; i < source->count; i++)
+            inner->keys[i] = source->keys[i];
+        for(size_type i = 0; i <= source->count; i++)
+            inner->children[i] = copyNode(source->children[i], previous);
+        inner->count = source->count;
+        return inner;
+  }
+
+  static void moveSlot(Leaf* from, size_type fromIndex, Leaf* to, size_type toIndex)
+  {
+        new (&to->slots[toIndex]) value_type(std::move(from->slot(fromIndex)));
+        from->slot(fromIndex).~value_type();
+        to->keys[toIndex] = from->keys[fromIndex];
+  }
+
+  // przesuwa sloty [index, count) o jeden w prawo; licznik zmienia wywolujacy
+  static void openGap(Leaf* leaf, size_type index)
+  {
+        for(size_type i = leaf->count; i > index; i--)
+            moveSlot(leaf, i - 1, leaf, i);
+  }
+
+  // slot index jest juz pusty; zsuwa reszte i zmniejsza licznik
+  static void closeGap(Leaf* leaf, size_type index)
+  {
+        for(size_type i = index + 1; i < leaf->count; i++)
+            moveSlot(leaf, i, leaf, i - 1);
+        leaf->count--;
+  }
+
+  Leaf* splitLeaf(Leaf* leaf)
+  {
+        Leaf* right = createLeaf();
+        const size_type keep = leaf->count / 2;
+        for(size_type i = keep; i < leaf->count; i++)
+            moveSlot(leaf, i, right, i - keep);
+        right->count = leaf->count - keep;
+        leaf->count = keep;
+
+        right->next = leaf->next;
+        right->prev = leaf;
+        if(leaf->next != nullptr)
+            leaf->next->prev = right;
+        else
+            last_leaf = right;
+        leaf->next = right;
+        return right;
+  }
+
+  void insertIntoParent(PathEntry* path, size_type level, Node* left, key_type separator, Node* right)
+  {
+        while(true)
+        {
+            if(level == 0)
+            {
+                Inner* top = createInner();
+                top->keys[0] = separator;
+                top->children[0] = left;
+                top->children[1] = right;
+                top->count = 1;
+                root = top;
+                return;
+            }
+
+            Inner* parent = path[level - 1].node;
+            const size_type index = path[level - 1].index;
+            std::move_backward(parent->keys + index, parent->keys + parent->count, parent->keys + parent->count + 1);
+            std::move_backward(parent->children + index + 1, parent->children + parent->count + 1,
+                               parent->children + parent->count + 2);
+            parent->keys[index] = separator;
+            parent->children[index + 1] = right;
+            parent->count++;
+
+            if(parent->count <= NODE_KEYS)
+                return;
+
+            // srodkowy klucz idzie pietro wyzej, nie zostaje w zadnej z polowek
+            Inner* sibling = createInner();
+            const size_type middle = parent->count / 2;
+            separator = parent->keys[middle];
+            std::move(parent->keys + middle + 1, parent->keys + parent->count, sibling->keys);
+            std::move(parent->children + middle + 1, parent->children + parent->count + 1, sibling->children);
+            sibling->count = parent->count - middle - 1;
+            parent->count = middle;
+
+            left = parent;
+            right = sibling;
+            level--;
+        }
+  }
+
+  // usuwa klucz index i dziecko index + 1
+  static void removeFromInner(Inner* inner, size_type index)
+  {
+        std::move(inner->keys + index + 1, inner->keys + inner->count, inner->keys + index);
+        std::move(inner->children + index + 2, inner->children + inner->count + 1, inner->children + index + 1);
+        inner->count--;
+  }
+
+  void rebalanceLeaf(Leaf* leaf, PathEntry* path, size_type depth)
+  {
+        if(depth == 0)
+        {
+            if(leaf->count == 0)
+            {
+                delete leaf;
+                root = nullptr;
+                first_leaf = last_leaf = nullptr;
+            }
+            return;
+        }
+        if(leaf->count >= MIN_KEYS)
+            return;
+
+        Inner* parent = path[depth - 1].node;
+        const size_type index = path[depth - 1].index;
+        Leaf* left = index > 0 ? asLeaf(parent->children[index - 1]) : nullptr;
+        Leaf* right = index < parent->count ? asLeaf(parent->children[index + 1]) : nullptr;
+
+        if(left != nullptr && left->count > MIN_KEYS)
+        {
+            openGap(leaf, 0);
+            moveSlot(left, left->count - 1, leaf, 0);
+            left->count--;
+            leaf->count++;
+            parent->keys[index - 1] = leaf->keys[0];
+            return;
+        }
+        if(right != nullptr && right->count > MIN_KEYS)
+        {
+            moveSlot(right, 0, leaf, leaf->count);
+            leaf->count++;
+            closeGap(right, 0);
+            parent->keys[index] = right->keys[0];
+            return;
+        }
+
+        if(left != nullptr)
+        {
+            mergeLeaves(left, leaf);
+            removeFromInner(parent, index - 1);
+        }
+        else
+        {
+            mergeLeaves(leaf, right);
+            removeFromInner(parent, index);
+        }
+        rebalanceInner(path, depth - 1);
+  }
+
+  void mergeLeaves(Leaf* left, Leaf* right)
+  {
+        for(size_type i = 0; i < right->count; i++)
+            moveSlot(right, i, left, left->count + i);
+        left->count += right->count;
+
+        left->next = right->next;
+        if(right->next != nullptr)
+            right->next->prev = left;
+        else
+            last_leaf = left;
+        delete right;
+  }
+
+  // path[level].node ma o jeden klucz mniej niz przed usunieciem
+  void rebalanceInner(PathEntry* path, size_type level)
+  {
+        while(true)
+        {
+            Inner* node = path[level].node;
+            if(level == 0)
+            {
+                if(node->count == 0)
+                {
+                    root = node->children[0];
+                    delete node;
+                }
+                return;
+            }
+            if(node->count >= MIN_KEYS)
+                return;
+
+            Inner* parent = path[level - 1].node;
+            const size_type index = path[level - 1].index;
+            Inner* left = index > 0 ? asInner(parent->children[index - 1]) : nullptr;
+            Inner* right = index < parent->count ? asInner(parent->children[index + 1]) : nullptr;
+
+            if(left != nullptr && left->count > MIN_KEYS)
+            {
+                std::move_backward(node->keys, node->keys + node->count, node->keys + node->count + 1);
+                std::move_backward(node->children, node->children + node->count + 1, node->children + node->count + 2);
+                node->keys[0] = parent->keys[index - 1];
+                node->children[0] = left->children[left->count];
+                parent->keys[index - 1] = left->keys[left->count - 1];
+                left->count--;
+                node->count++;
+                return;
+            }
+            if(right != nullptr && right->count > MIN_KEYS)
+            {
+                node->keys[node->count] = parent->keys[index];
+                node->children[node->count + 1] = right->children[0];
+                parent->keys[index] = right->keys[0];
+                std::move(right->keys + 1, right->keys + right->count, right->keys);
+                std::move(right->children + 1, right->children + right->count + 1, right->children);
+                right->count--;
+                node->count++;
+                return;
+            }
+
+            if(left != nullptr)
+            {
+                mergeInner(left, parent->keys[index - 1], node);
+                removeFromInner(parent, index - 1);
+            }
+            else
+            {
+                mergeInner(node, parent->keys[index], right);
+                removeFromInner(parent, index);
+            }
+            level--;
+        }
+  }
+
+  static void mergeInner(Inner* left, const key_type& separator, Inner* right)
+  {
+        left->keys[left->count] = separator;
+        std::move(right->keys, right->keys + right->count, left->keys + left->count + 1);
+        std::move(right->children, right->children + right->count + 1, left->children + left->count + 1);
+        left->count += right->count + 1;
+        delete right;
+  }
+};
+
+template <typename KeyType, typename ValueType>
+void swap(BPlusTreeMap<KeyType, ValueType>& left, BPlusTreeMap<KeyType, ValueType>& right) noexcept
+{
+  left.swap(right);
+}
+
+template <typename KeyType, typename ValueType>
+class BPlusTreeMap<KeyType, ValueType>::ConstIterator
+{
+public:
+  using reference = typename BPlusTreeMap::const_reference;
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename BPlusTreeMap::value_type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const typename BPlusTreeMap::value_type*;
+
+private:
+  const BPlusTreeMap* map;
+  const Leaf* leaf;
+  size_type index;
+  friend class BPlusTreeMap;
+
+public:
+
+  explicit ConstIterator(const BPlusTreeMap* map = nullptr, const Leaf* leaf = nullptr, size_type index = 0):
+      map(map), leaf(leaf), index(index)
+  {}
+
+  ConstIterator(const ConstIterator& other) : ConstIterator(other.map, other.leaf, other.index)
+  {}
+
+  ConstIterator& operator=(const ConstIterator& other) = default;
+
+  ConstIterator& operator++()
+  {
+    if(map == nullptr || leaf == nullptr)
+        throw std::out_of_range("operator++ out of range");
+    if(++index == leaf->count)
+    {
+        leaf = leaf->next;
+        index = 0;
+    }
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    auto result = *this;
+    operator++();
+    return result;
+  }
+
+  ConstIterator& operator--()
+  {
+    if(map == nullptr)
+        throw std::out_of_range("operator-- out of range");
+    if(leaf == nullptr)
+    {
+        if(map->last_leaf == nullptr)
+            throw std::out_of_range("operator-- out of range");
+        leaf = map->last_leaf;
+        index = leaf->count - 1;
+    }
+    else if(index > 0)
+        index--;
+    else
+    {
+        if(leaf->prev == nullptr)
+            throw std::out_of_range("operator-- out of range");
+        leaf = leaf->prev;
+        index = leaf->count - 1;
+    }
+    return *this;
+  }
+
+  ConstIterator operator--(int)
+  {
+    auto result = *this;
+    operator--();
+    return result;
+  }
+
+  reference operator*() const
+  {
+    if(map == nullptr || leaf == nullptr)
+        throw std::out_of_range("operator* out of range");
+    return leaf->slot(index);
+  }
+
+  pointer operator->() const
+  {
+    return &this->operator*();
+  }
+
+  bool operator==(const ConstIterator& other) const
+  {
+    return map == other.map && leaf == other.leaf && index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const
+  {
+    return !(*this == other);
+  }
+};
+
+template <typename KeyType, typename ValueType>
+class BPlusTreeMap<KeyType, ValueType>::Iterator : public BPlusTreeMap<KeyType, ValueType>::ConstIterator
+{
+public:
+  using reference = typename BPlusTreeMap::reference;
+  using pointer = typename BPlusTreeMap::value_type*;
+
+  explicit Iterator(BPlusTreeMap* map = nullptr, const Leaf* leaf = nullptr, size_type index = 0) :
+      ConstIterator(map, leaf, index)
+  {}
+
+  Iterator(const ConstIterator& other)
+    : ConstIterator(other)
+  {}
+
+  Iterator& operator++()
+  {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int)
+  {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator& operator--()
+  {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int)
+  {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  pointer operator->() const
+  {
+    return &this->operator*();
+  }
+
+  reference operator*() const
+  {
+    // ugly cast, yet reduces code duplication.
+    return const_cast<reference>(ConstIterator::operator*());
+  }
+};
+
+}
+
+#endif /* AISDI_MAPS_BPLUSTREEMAP_H */
@@ -0,0 +1,827 @@
+#ifndef AISDI_MAPS_COMPACTTREEMAP_H
+#define AISDI_MAPS_COMPACTTREEMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+template <bool ParentLinks>
+class CompactParentLink
+{
+public:
+  std::uint32_t parent;
+};
+
+// bez rodzica pole znika dzieki optymalizacji pustej klasy bazowej
+template <>
+class CompactParentLink<false>
+{};
+
+}
+
+// Drzewo czerwono-czarne (lewostronne, Sedgewick) trzymane w jednej ciaglej tablicy wezlow.
+// Dzieci wskazywane sa 32-bitowymi indeksami, a kolor zajmuje najstarszy bit indeksu
+// lewego dziecka. Usuniety wezel zastepowany jest ostatnim wezlem tablicy, wiec tablica
+// nie ma dziur. Przy ParentLinks = false wezel nie pamieta rodzica - iterator szuka wtedy
+// nastepnika od korzenia (O(log n) na krok) w zamian za kolejne 4 bajty mniej na wpis.
+template <typename KeyType, typename ValueType, bool ParentLinks = true>
+class CompactTreeMap
+{
+public:
+  using key_type = KeyType;
+  using mapped_type = ValueType;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+private:
+  using index_type = std::uint32_t;
+  using Slot = typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type;
+
+  static const index_type RED_BIT = 0x80000000u;
+  static const index_type INDEX_MASK = 0x7FFFFFFFu;
+  static const index_type NIL = INDEX_MASK;
+  static const size_type FIRST_CAPACITY = 16;
+
+  class Node : public detail::CompactParentLink<ParentLinks>
+  {
+  public:
+      index_type links[2];//lewy i prawy syn; najstarszy bit lewego - kolor wezla
+      Slot data;
+
+      value_type& datapair()
+      {
+          return *reinterpret_cast<value_type*>(&data);
+      }
+
+      const value_type& datapair() const
+      {
+          return *reinterpret_cast<const value_type*>(&data);
+      }
+  };
+
+  Node* nodes;
+  index_type root;
+  index_type counter;
+  index_type capacity;
+  index_type freed;//wezel zwolniony w trakcie usuwania; tablice domyka sie dopiero po nim
+
+public:
+
+  CompactTreeMap(): nodes(nullptr), root(NIL), counter(0), capacity(0), freed(NIL)
+  {}
+
+  CompactTreeMap(std::initializer_list<value_type> list): CompactTreeMap()
+  {
+        reserve(list.size());
+        for(auto it = list.begin(); it != list.end(); it++)
+            operator[]((*it).first) = (*it).second;
+  }
+
+  // indeksy sa wzgledne, wiec kopia tablicy wezel po wezle odtwarza cale drzewo
+  CompactTreeMap(const CompactTreeMap& other): CompactTreeMap()
+  {
+        reserve(other.counter);
+        for(index_type i = 0; i < other.counter; i++)
+        {
+            new (&nodes[i]) Node(other.nodes[i]);
+            try
+            {
+                new (&nodes[i].data) value_type(other.nodes[i].datapair());
+            }
+            catch(...)
+            {
+                counter = i;
+                throw;
+            }
+        }
+        counter = other.counter;
+        root = other.root;
+  }
+
+  CompactTreeMap(CompactTreeMap&& other) noexcept:
+      nodes(other.nodes), root(other.root), counter(other.counter), capacity(other.capacity), freed(NIL)
+  {
+        other.nodes = nullptr;
+        other.root = NIL;
+        other.counter = 0;
+        other.capacity = 0;
+  }
+
+  CompactTreeMap& operator=(const CompactTreeMap& other)
+  {
+        if(this != &other)
+        {
+            CompactTreeMap temp(other);
+            swap(temp);
+        }
+        return *this;
+  }
+
+  CompactTreeMap& operator=(CompactTreeMap&& other) noexcept
+  {
+        if(this != &other)
+        {
+            CompactTreeMap temp(std::move(other));
+            swap(temp);
+        }
+        return *this;
+  }
+
+  ~CompactTreeMap()
+  {
+        for(index_type i = 0; i < counter; i++)
+            nodes[i].datapair().~value_type();
+        ::operator delete(nodes);
+  }
+
+  void swap(CompactTreeMap& other) noexcept
+  {
+        std::swap(nodes, other.nodes);
+        std::swap(root, other.root);
+        std::swap(counter, other.counter);
+        std::swap(capacity, other.capacity);
+  }
+
+  bool isEmpty() const
+  {
+        return counter == 0;
+  }
+
+  size_type getSize() const
+  {
+        return counter;
+  }
+
+  // miejsce na count wezlow bez ponownej alokacji
+  void reserve(size_type count)
+  {
+        if(count > NIL)
+            throw std::length_error("CompactTreeMap: too many nodes");
+        if(count > capacity)
+            reallocate(static_cast<index_type>(count));
+  }
+
+  // bajty zajmowane przez jeden wpis (wezel razem z para)
+  static size_type nodeSize()
+  {
+        return sizeof(Node);
+  }
+
+  size_type height() const
+  {
+        return subtreeHeight(root);
+  }
+
+  mapped_type& operator[](const key_type& key)
+  {
+        index_type found = findIndex(key);
+        if(found != NIL)
+            return nodes[found].datapair().second;
+
+        if(counter == capacity)
+            reserve(capacity == 0 ? FIRST_CAPACITY : capacity * size_type(2));
+
+        root = insertNode(root, key, found);
+        setRed(root, false);
+        setParent(root, NIL);
+        return nodes[found].datapair().second;
+  }
+
+  const mapped_type& valueOf(const key_type& key) const
+  {
+        const index_type found = findIndex(key);
+        if(found == NIL)
+            throw std::out_of_range("valueOf out of range error");
+        return nodes[found].datapair().second;
+  }
+
+  mapped_type& valueOf(const key_type& key)
+  {
+        const index_type found = findIndex(key);
+        if(found == NIL)
+            throw std::out_of_range("valueOf out of range error");
+        return nodes[found].datapair().second;
+  }
+
+  const_iterator find(const key_type& key) const
+  {
+        return const_iterator(this, findIndex(key));
+  }
+
+  iterator find(const key_type& key)
+  {
+        return iterator(this, findIndex(key));
+  }
+
+  void remove(const key_type& key)
+  {
+        if(findIndex(key) == NIL)
+            throw std::out_of_range("remove out of range");
+
+        // korzen na czas zejscia staje sie czerwony, zeby zawsze bylo skad pozyczyc czerwien
+        if(!isRed(leftOf(root)) && !isRed(rightOf(root)))
+            setRed(root, true);
+        root = removeNode(root, key);
+        if(root != NIL)
+        {
+            setRed(root, false);
+            setParent(root, NIL);
+        }
+        closeHole();
+  }
+
+  void remove(const const_iterator& it)
+  {
+        if(it.map != this || it.index == NIL)
+            throw std::out_of_range("remove out of range");
+        const key_type key = nodes[it.index].datapair().first;
+        remove(key);
+  }
+
+  bool operator==(const CompactTreeMap& other) const
+  {
+        if(other.counter != counter)
+            return false;
+
+        for(auto it = begin(), otherIt = other.begin(); it != end(); ++it, ++otherIt)
+            if(it->first < otherIt->first || otherIt->first < it->first || !(it->second == otherIt->second))
+                return false;
+        return true;
+  }
+
+  bool operator!=(const CompactTreeMap& other) const
+  {
+        return !(*this == other);
+  }
+
+  iterator begin()
+  {
+        return iterator(cbegin());
+  }
+
+  iterator end()
+  {
+        return iterator(cend());
+  }
+
+  const_iterator cbegin() const
+  {
+        return const_iterator(this, root == NIL ? NIL : minIndex(root));
+  }
+
+  const_iterator cend() const
+  {
+        return const_iterator(this, NIL);
+  }
+
+  const_iterator begin() const
+  {
+        return cbegin();
+  }
+
+  const_iterator end() const
+  {
+        return cend();
+  }
+
+private:
+
+  const key_type& keyOf(index_type node) const
+  {
+        return nodes[node].datapair().first;
+  }
+
+  index_type leftOf(index_type node) const
+  {
+        return nodes[node].links[0] & INDEX_MASK;
+  }
+
+  index_type rightOf(index_type node) const
+  {
+        return nodes[node].links[1];
+  }
+
+  bool isRed(index_type node) const
+  {
+        return node != NIL && (nodes[node].links[0] & RED_BIT) != 0;
+  }
+
+  void setRed(index_type node, bool red)
+  {
+        nodes[node].links[0] = red ? (nodes[node].links[0] | RED_BIT) : (nodes[node].links[0] & INDEX_MASK);
+  }
+
+  index_type parentOf(index_type node) const
+  {
+        return parentOf(node, std::integral_constant<bool, ParentLinks>());
+  }
+
+  index_type parentOf(index_type node, std::true_type) const
+  {
+        return nodes[node].parent;
+  }
+
+  index_type parentOf(index_type, std::false_type) const
+  {
+        return NIL;
+  }
+
+  void setParent(index_type node, index_type parent)
+  {
+        if(node != NIL)
+            setParent(node, parent, std::integral_constant<bool, ParentLinks>());
+  }
+
+  void setParent(index_type node, index_type parent, std::true_type)
+  {
+        nodes[node].parent = parent;
+  }
+
+  void setParent(index_type, index_type, std::false_type)
+  {}
+
+  void setLeft(index_type node, index_type child)
+  {
+        nodes[node].links[0] = (nodes[node].links[0] & RED_BIT) | child;
+        setParent(child, node);
+  }
+
+  void setRight(index_type node, index_type child)
+  {
+        nodes[node].links[1] = child;
+        setParent(child, node);
+  }
+
+  index_type findIndex(const key_type& key) const
+  {
+        const Node* base = nodes;
+        index_type temp = root;
+        while(temp != NIL)
+        {
+            const Node& node = base[temp];
+            const key_type& nodeKey = node.datapair().first;
+            const bool greater = nodeKey < key;
+            if(!greater && !(key < nodeKey))
+                return temp;
+            // syn wybierany indeksem, nie skokiem - kierunek zejscia jest nieprzewidywalny
+            temp = node.links[greater] & INDEX_MASK;
+        }
+        return NIL;
+  }
+
+  index_type minIndex(index_type node) const
+  {
+        while(leftOf(node) != NIL)
+            node = leftOf(node);
+        return node;
+  }
+
+  index_type maxIndex(index_type node) const
+  {
+        while(rightOf(node) != NIL)
+            node = rightOf(node);
+        return node;
+  }
+
+  index_type successor(index_type node) const
+  {
+        return successor(node, std::integral_constant<bool, ParentLinks>());
+  }
+
+  index_type successor(index_type node, std::true_type) const
+  {
+        if(rightOf(node) != NIL)
+            return minIndex(rightOf(node));
+        index_type parent = parentOf(node);
+        while(parent != NIL && rightOf(parent) == node)
+        {
+            node = parent;
+            parent = parentOf(node);
+        }
+        return parent;
+  }
+
+  // bez rodzicow: pierwszy klucz wiekszy od biezacego, szukany od korzenia
+  index_type successor(index_type node, std::false_type) const
+  {
+        if(rightOf(node) != NIL)
+            return minIndex(rightOf(node));
+        const key_type& key = keyOf(node);
+        index_type result = NIL;
+        for(index_type temp = root; temp != NIL;)
+        {
+            if(key < keyOf(temp))
+            {
+                result = temp;
+                temp = leftOf(temp);
+            }
+            else
+                temp = rightOf(temp);
+        }
+        return result;
+  }
+
+  index_type predecessor(index_type node) const
+  {
+        return predecessor(node, std::integral_constant<bool, ParentLinks>());
+  }
+
+  index_type predecessor(index_type node, std::true_type) const
+  {
+        if(leftOf(node) != NIL)
+            return maxIndex(leftOf(node));
+        index_type parent = parentOf(node);
+        while(parent != NIL && leftOf(parent) == node)
+        {
+            node = parent;
+            parent = parentOf(node);
+        }
+        return parent;
+  }
+
+  index_type predecessor(index_type node, std::false_type) const
+  {
+        if(leftOf(node) != NIL)
+            return maxIndex(leftOf(node));
+        const key_type& key = keyOf(node);
+        index_type result = NIL;
+        for(index_type temp = root; temp != NIL;)
+        {
+            if(keyOf(temp) < key)
+            {
+                result = temp;
+                temp = rightOf(temp);
+            }
+            else
+                temp = leftOf(temp);
+        }
+        return result;
+  }
+
+  size_type subtreeHeight(index_type node) const
+  {
+        if(node == NIL)
+            return 0;
+        const size_type left = subtreeHeight(leftOf(node));
+        const size_type right = subtreeHeight(rightOf(node));
+        return 1 + (left > right ? left : right);
+  }
+
+  void reallocate(index_type newCapacity)
+  {
+        Node* newNodes = static_cast<Node*>(::operator new(newCapacity * sizeof(Node)));
+        for(index_type i = 0; i < counter; i++)
+        {
+            new (&newNodes[i]) Node(nodes[i]);
+            new (&newNodes[i].data) value_type(std::move(nodes[i].datapair()));
+            nodes[i].datapair().~value_type();
+        }
+        ::operator delete(nodes);
+        nodes = newNodes;
+        capacity = newCapacity;
+  }
+
+  index_type createNode(const key_type& key)
+  {
+        const index_type node = counter;
+        new (&nodes[node].data) value_type(key, mapped_type());
+        nodes[node].links[0] = NIL | RED_BIT;
+        nodes[node].links[1] = NIL;
+        setParent(node, NIL);
+        counter++;
+        return node;
+  }
+
+  index_type rotateLeft(index_type node)
+  {
+        const index_type pivot = rightOf(node);
+        setRight(node, leftOf(pivot));
+        setLeft(pivot, node);
+        setRed(pivot, isRed(node));
+        setRed(node, true);
+        return pivot;
+  }
+
+  index_type rotateRight(index_type node)
+  {
+        const index_type pivot = leftOf(node);
+        setLeft(node, rightOf(pivot));
+        setRight(pivot, node);
+        setRed(pivot, isRed(node));
+        setRed(node, true);
+        return pivot;
+  }
+
+  void flipColors(index_type node)
+  {
+        setRed(node, !isRed(node));
+        setRed(leftOf(node), !isRed(leftOf(node)));
+        setRed(rightOf(node), !isRed(rightOf(node)));
+  }
+
+  // przywraca lewostronnosc po zmianie w poddrzewie; wynik to nowy korzen poddrzewa
+  index_type balance(index_type node)
+  {
+        if(isRed(rightOf(node)) && !isRed(leftOf(node)))
+            node = rotateLeft(node);
+        if(isRed(leftOf(node)) && isRed(leftOf(leftOf(node))))
+            node = rotateRight(node);
+        if(isRed(leftOf(node)) && isRed(rightOf(node)))
+            flipColors(node);
+        return node;
+  }
+
+  index_type moveRedLeft(index_type node)
+  {
+        flipColors(node);
+        if(isRed(leftOf(rightOf(node))))
+        {
+            setRight(node, rotateRight(rightOf(node)));
+            node = rotateLeft(node);
+            flipColors(node);
+        }
+        return node;
+  }
+
+  index_type moveRedRight(index_type node)
+  {
+        flipColors(node);
+        if(isRed(leftOf(leftOf(node))))
+        {
+            node = rotateRight(node);
+            flipColors(node);
+        }
+        return node;
+  }
+
+  // klucza nie ma w drzewie, a w tablicy jest wolne miejsce
+  index_type insertNode(index_type node, const key_type& key, index_type& inserted)
+  {
+        if(node == NIL)
+        {
+            inserted = createNode(key);
+            return inserted;
+        }
+        if(key < keyOf(node))
+            setLeft(node, insertNode(leftOf(node), key, inserted));
+        else
+            setRight(node, insertNode(rightOf(node), key, inserted));
+        return balance(node);
+  }
+
+  void releaseNode(index_type node)
+  {
+        nodes[node].datapair().~value_type();
+        freed = node;
+  }
+
+  index_type removeMin(index_type node)
+  {
+        if(leftOf(node) == NIL)
+        {
+            releaseNode(node);
+            return NIL;
+        }
+        if(!isRed(leftOf(node)) && !isRed(leftOf(leftOf(node))))
+            node = moveRedLeft(node);
+        setLeft(node, removeMin(leftOf(node)));
+        return balance(node);
+  }
+
+  // klucz musi byc w drzewie
+  index_type removeNode(index_type node, const key_type& key)
+  {
+        if(key < keyOf(node))
+        {
+            if(!isRed(leftOf(node)) && !isRed(leftOf(leftOf(node))))
+                node = moveRedLeft(node);
+            setLeft(node, removeNode(leftOf(node), key));
+            return balance(node);
+        }
+
+        if(isRed(leftOf(node)))
+            node = rotateRight(node);
+        if(!(keyOf(node) < key) && rightOf(node) == NIL)
+        {
+            releaseNode(node);
+            return NIL;
+        }
+        if(!isRed(rightOf(node)) && !isRed(leftOf(rightOf(node))))
+            node = moveRedRight(node);
+        if(!(keyOf(node) < key))
+        {
+            // para nastepnika przechodzi do tego wezla, a zwalniany jest wezel nastepnika
+            const index_type successorNode = minIndex(rightOf(node));
+            nodes[node].datapair().~value_type();
+            new (&nodes[node].data) value_type(std::move(nodes[successorNode].datapair()));
+            setRight(node, removeMin(rightOf(node)));
+        }
+        else
+            setRight(node, removeNode(rightOf(node), key));
+        return balance(node);
+  }
+
+  // przenosi ostatni wezel tablicy w miejsce zwolnionego i poprawia wskazujace na niego indeksy
+  void closeHole()
+  {
+        const index_type hole = freed;
+        const index_type last = counter - 1;
+        freed = NIL;
+        counter--;
+        if(hole == last)
+            return;
+
+        const index_type parent = ParentLinks ? parentOf(last) : findParent(keyOf(last));
+        new (&nodes[hole]) Node(nodes[last]);
+        new (&nodes[hole].data) value_type(std::move(nodes[last].datapair()));
+        nodes[last].datapair().~value_type();
+
+        if(parent == NIL)
+            root = hole;
+        else if(leftOf(parent) == last)
+            setLeft(parent, hole);
+        else
+            setRight(parent, hole);
+        setParent(leftOf(hole), hole);
+        setParent(rightOf(hole), hole);
+  }
+
+  index_type findParent(const key_type& key) const
+  {
+        index_type parent = NIL;
+        index_type temp = root;
+        while(temp != NIL && (key < keyOf(temp) || keyOf(temp) < key))
+        {
+            parent = temp;
+            temp = key < keyOf(temp) ? leftOf(temp) : rightOf(temp);
+        }
+        return parent;
+  }
+};
+
+template <typename KeyType, typename ValueType, bool ParentLinks>
+void swap(CompactTreeMap<KeyType, ValueType, ParentLinks>& left,
+          CompactTreeMap<KeyType, ValueType, ParentLinks>& right) noexcept
+{
+  left.swap(right);
+}
+
+template <typename KeyType, typename ValueType, bool ParentLinks>
+class CompactTreeMap<KeyType, ValueType, ParentLinks>::ConstIterator
+{
+public:
+  using reference = typename CompactTreeMap::const_reference;
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename CompactTreeMap::value_type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const typename CompactTreeMap::value_type*;
+
+private:
+  const CompactTreeMap* map;
+  index_type index;
+  friend class CompactTreeMap;
+
+public:
+
+  explicit ConstIterator(const CompactTreeMap* map = nullptr, index_type index = NIL): map(map), index(index)
+  {}
+
+  ConstIterator(const ConstIterator& other) : ConstIterator(other.map, other.index)
+  {}
+
+  ConstIterator& operator=(const ConstIterator& other) = default;
+
+  ConstIterator& operator++()
+  {
+    if(map == nullptr || index == NIL)
+        throw std::out_of_range("operator++ out of range");
+    index = map->successor(index);
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    auto result = *this;
+    operator++();
+    return result;
+  }
+
+  ConstIterator& operator--()
+  {
+    if(map == nullptr || map->root == NIL)
+        throw std::out_of_range("operator-- out of range");
+    if(index == NIL)
+        index = map->maxIndex(map->root);
+    else
+    {
+        const index_type previous = map->predecessor(index);
+        if(previous == NIL)
+            throw std::out_of_range("operator-- out of range");
+        index = previous;
+    }
+    return *this;
+  }
+
+  ConstIterator operator--(int)
+  {
+    auto result = *this;
+    operator--();
+    return result;
+  }
+
+  reference operator*() const
+  {
+    if(map == nullptr || index == NIL)
+        throw std::out_of_range("operator* out of range");
+    return map->nodes[index].datapair();
+  }
+
+  pointer operator->() const
+  {
+    return &this->operator*();
+  }
+
+  bool operator==(const ConstIterator& other) const
+  {
+    return map == other.map && index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const
+  {
+    return !(*this == other);
+  }
+};
+
+template <typename KeyType, typename ValueType, bool ParentLinks>
+class CompactTreeMap<KeyType, ValueType, ParentLinks>::Iterator
+    : public CompactTreeMap<KeyType, ValueType, ParentLinks>::ConstIterator
+{
+public:
+  using reference = typename CompactTreeMap::reference;
+  using pointer = typename CompactTreeMap::value_type*;
+
+  explicit Iterator(CompactTreeMap* map = nullptr, index_type index = NIL) : ConstIterator(map, index)
+  {}
+
+  Iterator(const ConstIterator& other)
+    : ConstIterator(other)
+  {}
+
+  Iterator& operator++()
+  {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int)
+  {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator& operator--()
+  {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int)
+  {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  pointer operator->() const
+  {
+    return &this->operator*();
+  }
+
+  reference operator*() const
+  {
+    // ugly cast, yet reduces code duplication.
+    return const_cast<reference>(ConstIterator::operator*());
+  }
+};
+
+}
+
+#endif /* AISDI_MAPS_COMPACTTREEMAP_H */
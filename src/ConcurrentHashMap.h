@@ -0,0 +1,358 @@
+#ifndef AISDI_MAPS_CONCURRENTHASHMAP_H
+#define AISDI_MAPS_CONCURRENTHASHMAP_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace aisdi
+{
+
+// Mapa z lancuchowaniem jak HashMap, ale bezpieczna watkowo: kubelki podzielone sa na
+// pasy (stripe), kazdy z wlasna blokada czytelnikow-pisarzy. Kubelek b nalezy do pasa
+// b & (stripes - 1), wiec przebudowa tablicy nie zmienia przydzialu kluczy do pasow.
+// Iteratorow nie ma - wyniki zwracane sa przez kopie.
+template <typename KeyType, typename ValueType,
+          typename Hash = std::hash<KeyType>,
+          typename KeyEqual = std::equal_to<KeyType>>
+class ConcurrentHashMap
+{
+public:
+  using key_type = KeyType;
+  using mapped_type = ValueType;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+private:
+    class HashNode
+    {
+         public:
+        HashNode *next;
+        size_type hash;//pelny skrot klucza, liczony tylko raz
+        value_type datapair;
+
+        HashNode(const key_type& key, const mapped_type& mapped, size_type hash):
+            next(nullptr), hash(hash), datapair(key, mapped){}
+    };
+
+    // blokady w osobnych liniach pamieci podrecznej, zeby pasy nie rywalizowaly o jedna linie
+    class Stripe
+    {
+         public:
+        mutable std::shared_timed_mutex lock;
+        char padding[64];
+    };
+
+    static const size_type DEFAULT_TABLE_SIZE = 64;
+    static const size_type DEFAULT_STRIPES = 64;
+
+    hasher hash_function;
+    key_equal key_eq;
+    std::vector<Stripe> stripes;
+    HashNode** hashtable;
+    size_type table_size;//potega dwojki, nie mniejsza niz liczba pasow
+    std::atomic<size_type> counter;
+    float max_load_factor;
+
+public:
+
+  ConcurrentHashMap(): ConcurrentHashMap(DEFAULT_TABLE_SIZE)
+  {}
+
+  explicit ConcurrentHashMap(size_type bucketCount, size_type stripeCount = DEFAULT_STRIPES,
+                             const hasher& hash = hasher(), const key_equal& equal = key_equal()):
+      hash_function(hash), key_eq(equal), stripes(roundToPowerOfTwo(stripeCount)), hashtable(nullptr),
+      table_size(0), counter(0), max_load_factor(1.0f)
+  {
+        table_size = roundToPowerOfTwo(bucketCount < stripes.size() ? stripes.size() : bucketCount);
+        hashtable = new HashNode* [table_size];
+        for(size_type i = 0; i < table_size; i++)
+            hashtable[i] = nullptr;
+  }
+
+  ConcurrentHashMap(std::initializer_list<value_type> list): ConcurrentHashMap(list.size())
+  {
+        for(auto it = list.begin(); it != list.end(); it++)
+            insertOrAssign((*it).first, (*it).second);
+  }
+
+  ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+  ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+  ~ConcurrentHashMap()
+  {
+        eraseHashMap();
+        delete[] hashtable;
+  }
+
+  bool isEmpty() const
+  {
+        return getSize() == 0;
+  }
+
+  size_type getSize() const
+  {
+        return counter.load(std::memory_order_relaxed);
+  }
+
+  size_type bucketCount() const
+  {
+        std::shared_lock<std::shared_timed_mutex> guard(stripes[0].lock);
+        return table_size;
+  }
+
+  size_type stripeCount() const
+  {
+        return stripes.size();
+  }
+
+  bool contains(const key_type& key) const
+  {
+        const size_type hash = hash_function(key);
+        std::shared_lock<std::shared_timed_mutex> guard(stripeOf(hash).lock);
+        return findNode(key, hash) != nullptr;
+  }
+
+  // kopiuje wartosc do result; false, gdy klucza nie ma
+  bool find(const key_type& key, mapped_type& result) const
+  {
+        const size_type hash = hash_function(key);
+        std::shared_lock<std::shared_timed_mutex> guard(stripeOf(hash).lock);
+        HashNode* node = findNode(key, hash);
+        if(node == nullptr)
+            return false;
+        result = node->datapair.second;
+        return true;
+  }
+
+  mapped_type valueOf(const key_type& key) const
+  {
+        mapped_type result;
+        if(!find(key, result))
+            throw std::out_of_range("valueOf out of range error");
+        return result;
+  }
+
+  // dodaje pare, jesli klucza nie ma; istniejaca wartosc zostaje bez zmian
+  bool insert(const key_type& key, const mapped_type& mapped)
+  {
+        const size_type hash = hash_function(key);
+        {
+            std::unique_lock<std::shared_timed_mutex> guard(stripeOf(hash).lock);
+            if(findNode(key, hash) != nullptr)
+                return false;
+            linkNew(key, mapped, hash);
+        }
+        growIfNeeded();
+        return true;
+  }
+
+  // zwraca true, gdy klucz zostal dodany, false, gdy nadpisano wartosc
+  bool insertOrAssign(const key_type& key, const mapped_type& mapped)
+  {
+        const size_type hash = hash_function(key);
+        {
+            std::unique_lock<std::shared_timed_mutex> guard(stripeOf(hash).lock);
+            HashNode* node = findNode(key, hash);
+            if(node != nullptr)
+            {
+                node->datapair.second = mapped;
+                return false;
+            }
+            linkNew(key, mapped, hash);
+        }
+        growIfNeeded();
+        return true;
+  }
+
+  // compute(key) wywolywane jest co najwyzej raz dla danego klucza, pod blokada pasa
+  template <typename Compute>
+  mapped_type computeIfAbsent(const key_type& key, Compute compute)
+  {
+        const size_type hash = hash_function(key);
+        {
+            std::shared_lock<std::shared_timed_mutex> guard(stripeOf(hash).lock);
+            HashNode* node = findNode(key, hash);
+            if(node != nullptr)
+                return node->datapair.second;
+        }
+
+        mapped_type result;
+        {
+            std::unique_lock<std::shared_timed_mutex> guard(stripeOf(hash).lock);
+            HashNode* node = findNode(key, hash);
+            if(node != nullptr)
+                return node->datapair.second;
+            result = linkNew(key, compute(key), hash)->datapair.second;
+        }
+        growIfNeeded();
+        return result;
+  }
+
+  bool remove(const key_type& key)
+  {
+        const size_type hash = hash_function(key);
+        std::unique_lock<std::shared_timed_mutex> guard(stripeOf(hash).lock);
+
+        HashNode** link = &hashtable[bucketOf(hash)];
+        while(*link != nullptr)
+        {
+            HashNode* node = *link;
+            if(node->hash == hash && key_eq(node->datapair.first, key))
+            {
+                *link = node->next;
+                delete node;
+                counter.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            link = &node->next;
+        }
+        return false;
+  }
+
+  void clear()
+  {
+        AllStripes guard(*this);
+        eraseHashMap();
+  }
+
+private:
+
+  // blokuje wszystkie pasy zawsze w tej samej kolejnosci - brak zakleszczen z operacjami na jednym pasie
+  class AllStripes
+  {
+  public:
+      explicit AllStripes(const ConcurrentHashMap& map): map(map)
+      {
+          for(auto& stripe : map.stripes)
+              stripe.lock.lock();
+      }
+
+      ~AllStripes()
+      {
+          for(auto it = map.stripes.rbegin(); it != map.stripes.rend(); ++it)
+              it->lock.unlock();
+      }
+
+      AllStripes(const AllStripes&) = delete;
+      AllStripes& operator=(const AllStripes&) = delete;
+
+  private:
+      const ConcurrentHashMap& map;
+  };
+
+  static size_type roundToPowerOfTwo(size_type count)
+  {
+      size_type result = 1;
+      while(result < count)
+          result *= 2;
+      return result;
+  }
+
+  static size_type mix(size_type hash)
+  {
+      std::uint64_t mixed = static_cast<std::uint64_t>(hash) * 11400714819323198485ull;
+      return static_cast<size_type>(mixed ^ (mixed >> 32));
+  }
+
+  const Stripe& stripeOf(size_type hash) const
+  {
+      return stripes[mix(hash) & (stripes.size() - 1)];
+  }
+
+  size_type bucketOf(size_type hash) const
+  {
+      return mix(hash) & (table_size - 1);
+  }
+
+  HashNode* findNode(const key_type& key, size_type hash) const
+  {
+      for(HashNode* temp = hashtable[bucketOf(hash)]; temp != nullptr; temp = temp->next)
+          if(temp->hash == hash && key_eq(temp->datapair.first, key))
+              return temp;
+      return nullptr;
+  }
+
+  // wywolywane pod wylaczna blokada pasa klucza
+  HashNode* linkNew(const key_type& key, const mapped_type& mapped, size_type hash)
+  {
+      HashNode* node = new HashNode(key, mapped, hash);
+      const size_type index = bucketOf(hash);
+      node->next = hashtable[index];
+      hashtable[index] = node;
+      counter.fetch_add(1, std::memory_order_relaxed);
+      return node;
+  }
+
+  void growIfNeeded()
+  {
+      if(getSize() <= loadLimit(bucketCount()))
+          return;
+
+      AllStripes guard(*this);
+      if(counter.load(std::memory_order_relaxed) <= loadLimit(table_size))
+          return;
+      rehash(table_size * 2);
+  }
+
+  size_type loadLimit(size_type buckets) const
+  {
+      return static_cast<size_type>(buckets * max_load_factor);
+  }
+
+  // wywolywane pod wszystkimi blokadami
+  void rehash(size_type bucketCount)
+  {
+      HashNode** newtable = new HashNode* [bucketCount];
+      for(size_type i = 0; i < bucketCount; i++)
+          newtable[i] = nullptr;
+
+      HashNode** oldtable = hashtable;
+      const size_type oldsize = table_size;
+      hashtable = newtable;
+      table_size = bucketCount;
+
+      for(size_type i = 0; i < oldsize; i++)
+      {
+          HashNode* temp = oldtable[i];
+          while(temp != nullptr)
+          {
+              HashNode* next = temp->next;
+              const size_type index = bucketOf(temp->hash);
+              temp->next = hashtable[index];
+              hashtable[index] = temp;
+              temp = next;
+          }
+      }
+      delete[] oldtable;
+  }
+
+  void eraseHashMap()
+  {
+      for(size_type i = 0; i < table_size; i++)
+      {
+          HashNode* temp = hashtable[i];
+          while(temp != nullptr)
+          {
+              HashNode* next = temp->next;
+              delete temp;
+              temp = next;
+          }
+          hashtable[i] = nullptr;
+      }
+      counter.store(0, std::memory_order_relaxed);
+  }
+};
+
+}
+
+#endif /* AISDI_MAPS_CONCURRENTHASHMAP_H */
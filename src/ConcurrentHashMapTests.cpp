@@ -0,0 +1,167 @@
+#include <ConcurrentHashMap.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedKeyTypes = boost::mpl::list<std::int32_t, std::uint64_t>;
+
+template <typename K>
+using Map = aisdi::ConcurrentHashMap<K, std::string>;
+
+BOOST_AUTO_TEST_SUITE(ConcurrentHashMapsTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map;
+
+  BOOST_CHECK(map.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInitializingFromListOfPairs_ThenAllItemsAreInMap,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map = { { 753, "Rome" }, { 1789, "Paris" } };
+
+  BOOST_CHECK_EQUAL(map.getSize(), 2u);
+  BOOST_CHECK_EQUAL(map.valueOf(753), "Rome");
+  BOOST_CHECK_EQUAL(map.valueOf(1789), "Paris");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenSearchingForMissingKey_ThenFalseIsReturned,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map = { { 753, "Rome" } };
+  std::string value;
+
+  BOOST_CHECK(!map.find(1789, value));
+  BOOST_CHECK(!map.contains(1789));
+  BOOST_CHECK_THROW(map.valueOf(1789), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenInsertingExistingKey_ThenValueIsNotChanged,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" } };
+
+  BOOST_CHECK(!map.insert(42, "Bob"));
+  BOOST_CHECK_EQUAL(map.valueOf(42), "Alice");
+  BOOST_CHECK(!map.insertOrAssign(42, "Bob"));
+  BOOST_CHECK_EQUAL(map.valueOf(42), "Bob");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenRemovingKey_ThenItemIsRemoved,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  BOOST_CHECK(map.remove(27));
+  BOOST_CHECK(!map.remove(27));
+  BOOST_CHECK_EQUAL(map.getSize(), 1u);
+  BOOST_CHECK(!map.contains(27));
+  BOOST_CHECK(map.contains(42));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenAddingManyItems_ThenTableGrows,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(64, 4);
+
+  for (K i = 0; i < 10000; ++i)
+    map.insert(i, std::to_string(i));
+
+  BOOST_CHECK(map.bucketCount() >= 10000u);
+  BOOST_CHECK_EQUAL(map.getSize(), 10000u);
+  BOOST_CHECK_EQUAL(map.valueOf(9999), "9999");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyThreads_WhenInsertingDisjointKeys_ThenAllItemsAreInMap,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&map, t]() {
+      for (K i = 0; i < 5000; ++i)
+        map.insert(static_cast<K>(t * 5000 + i), "x");
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  BOOST_CHECK_EQUAL(map.getSize(), 20000u);
+  for (K i = 0; i < 20000; ++i)
+    BOOST_REQUIRE(map.contains(i));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyThreads_WhenComputingSameKeys_ThenEachValueIsComputedOnce,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::atomic<int> computations(0);
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&map, &computations]() {
+      for (K i = 0; i < 1000; ++i)
+        map.computeIfAbsent(i, [&computations](const K& key) {
+          ++computations;
+          return std::to_string(key);
+        });
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  BOOST_CHECK_EQUAL(computations.load(), 1000);
+  BOOST_CHECK_EQUAL(map.valueOf(999), "999");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenReadersAndWriters_WhenRunningConcurrently_ThenReadersSeeStableKeys,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (K i = 0; i < 1000; ++i)
+    map.insert(i, "stable");
+
+  std::atomic<bool> failed(false);
+  std::vector<std::thread> threads;
+  threads.emplace_back([&map]() {
+    for (K i = 1000; i < 20000; ++i)
+    {
+      map.insert(i, "x");
+      if (i % 2 == 0)
+        map.remove(i);
+    }
+  });
+  for (int t = 0; t < 3; ++t)
+    threads.emplace_back([&map, &failed]() {
+      std::string value;
+      for (int round = 0; round < 20; ++round)
+        for (K i = 0; i < 1000; ++i)
+          if (!map.find(i, value) || value != "stable")
+            failed = true;
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  BOOST_CHECK(!failed.load());
+  BOOST_CHECK_EQUAL(map.getSize(), 1000u + 9500u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
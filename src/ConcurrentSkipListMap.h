@@ -0,0 +1,609 @@
+#ifndef AISDI_MAPS_CONCURRENTSKIPLISTMAP_H
+#define AISDI_MAPS_CONCURRENTSKIPLISTMAP_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "EpochReclamation.h"
+
+namespace aisdi
+{
+
+// Uporzadkowana mapa bez blokad - lista z przeskokami Herlihy'ego i Shavita. Usuniecie to
+// oznaczenie najmlodszego bitu wskaznikow "next" wezla (od gory do poziomu 0 - kto oznaczy
+// poziom 0, ten usunal); kazde przejscie odpina napotkane oznaczone wezly. Wezel oddaje
+// do EpochReclamation ostatni z dwoch wlascicieli: watek, ktory go wstawial, i ten, ktory
+// go usunal, bo wstawiajacy moze jeszcze doczepiac wyzsze poziomy po usunieciu.
+// Wartosc jest niezmienna para pod atomowym wskaznikiem, wiec zmiana wartosci to podmiana pary.
+// Iteratory sa slabo spojne: widza klucze rosnaco, a zmiany rownolegle moga, ale nie musza
+// byc widoczne. Iterator trzyma przypiecie do epoki, wiec musi zyc w watku, ktory go utworzyl.
+template <typename KeyType, typename ValueType>
+class ConcurrentSkipListMap
+{
+public:
+  using key_type = KeyType;
+  using mapped_type = ValueType;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+
+  class ConstIterator;
+  class ValueReference;
+  using const_iterator = ConstIterator;
+  using iterator = ConstIterator;
+
+  static const int MAX_LEVEL = 32;
+
+private:
+
+  class Node;
+
+  // wskaznik na nastepnika z bitem "usuniety" w najmlodszym bicie
+  class Link
+  {
+  public:
+      Link(): bits(0){}
+
+      Node* pointer() const
+      {
+          return reinterpret_cast<Node*>(bits.load() & ~std::uintptr_t(1));
+      }
+
+      Node* get(bool& marked) const
+      {
+          const std::uintptr_t value = bits.load();
+          marked = (value & 1) != 0;
+          return reinterpret_cast<Node*>(value & ~std::uintptr_t(1));
+      }
+
+      bool isMarked() const
+      {
+          return (bits.load() & 1) != 0;
+      }
+
+      void store(Node* node)
+      {
+          bits.store(reinterpret_cast<std::uintptr_t>(node), std::memory_order_relaxed);
+      }
+
+      bool compareAndSet(Node* expected, Node* desired)
+      {
+          std::uintptr_t old = reinterpret_cast<std::uintptr_t>(expected);
+          return bits.compare_exchange_strong(old, reinterpret_cast<std::uintptr_t>(desired));
+      }
+
+      // true, gdy to to wywolanie ustawilo znacznik
+      bool mark()
+      {
+          return (bits.fetch_or(1) & 1) == 0;
+      }
+
+  private:
+      std::atomic<std::uintptr_t> bits;
+  };
+
+  class Node
+  {
+  public:
+      const key_type key;
+      std::atomic<const value_type*> item;
+      std::atomic<int> owners;
+      const int height;
+
+      Link* links()
+      {
+          return reinterpret_cast<Link*>(this + 1);
+      }
+
+      // tablica polaczen lezy tuz za wezlem, wiec wezel ma tyle poziomow, ile potrzebuje
+      static Node* create(const key_type& key, const mapped_type& mapped, int height)
+      {
+          const value_type* item = new value_type(key, mapped);
+          void* memory;
+          try
+          {
+              memory = ::operator new(sizeof(Node) + height * sizeof(Link));
+          }
+          catch(...)
+          {
+              delete item;
+              throw;
+          }
+
+          Node* node;
+          try
+          {
+              node = new (memory) Node(key, item, height);
+          }
+          catch(...)
+          {
+              ::operator delete(memory);
+              delete item;
+              throw;
+          }
+          for(int level = 0; level < height; level++)
+              new (node->links() + level) Link();
+          return node;
+      }
+
+      static void destroy(void* pointer)
+      {
+          Node* node = static_cast<Node*>(pointer);
+          delete node->item.load();
+          for(int level = 0; level < node->height; level++)
+              node->links()[level].~Link();
+          node->~Node();
+          ::operator delete(node);
+      }
+
+  private:
+      Node(const key_type& key, const value_type* item, int height):
+          key(key), item(item), owners(2), height(height){}
+  };
+
+  mutable Link head[MAX_LEVEL];
+  std::atomic<int> levels;//liczba uzywanych poziomow; wyszukiwanie zaczyna sie od najwyzszego
+  std::atomic<size_type> counter;
+
+public:
+
+  ConcurrentSkipListMap(): levels(1), counter(0)
+  {}
+
+  ConcurrentSkipListMap(std::initializer_list<value_type> list): ConcurrentSkipListMap()
+  {
+        for(auto it = list.begin(); it != list.end(); it++)
+            insertOrAssign((*it).first, (*it).second);
+  }
+
+  ConcurrentSkipListMap(const ConcurrentSkipListMap&) = delete;
+  ConcurrentSkipListMap& operator=(const ConcurrentSkipListMap&) = delete;
+
+  // zaklada, ze zaden watek nie korzysta juz z mapy; wezly usuniete wczesniej zwolni domena epok
+  ~ConcurrentSkipListMap()
+  {
+        Node* temp = head[0].pointer();
+        while(temp != nullptr)
+        {
+            Node* next = temp->links()[0].pointer();
+            Node::destroy(temp);
+            temp = next;
+        }
+  }
+
+  bool isEmpty() const
+  {
+        return getSize() == 0;
+  }
+
+  // przy rownoleglych zmianach to tylko przyblizenie
+  size_type getSize() const
+  {
+        return counter.load(std::memory_order_relaxed);
+  }
+
+  bool contains(const key_type& key) const
+  {
+        EpochReclamation::Guard guard;
+        return findNode(key) != nullptr;
+  }
+
+  mapped_type valueOf(const key_type& key) const
+  {
+        EpochReclamation::Guard guard;
+        Node* node = findNode(key);
+        if(node == nullptr)
+            throw std::out_of_range("valueOf out of range error");
+        return node->item.load()->second;
+  }
+
+  const_iterator find(const key_type& key) const
+  {
+        const_iterator result(this);
+        result.moveTo(findNode(key));
+        return result;
+  }
+
+  // pierwszy klucz >= key
+  const_iterator lowerBound(const key_type& key) const
+  {
+        const_iterator result(this);
+        result.moveTo(lowerBoundNode(key));
+        return result;
+  }
+
+  // map[key] = value wstawia albo podmienia wartosc; odczyt map[key] dodaje brakujacy klucz
+  // z wartoscia domyslna, tak jak w TreeMap
+  ValueReference operator[](const key_type& key)
+  {
+        return ValueReference(*this, key);
+  }
+
+  // dodaje pare, jesli klucza nie ma; istniejaca wartosc zostaje bez zmian
+  bool insert(const key_type& key, const mapped_type& mapped)
+  {
+        return put(key, mapped, false);
+  }
+
+  // zwraca true, gdy klucz zostal dodany, false, gdy podmieniono wartosc
+  bool insertOrAssign(const key_type& key, const mapped_type& mapped)
+  {
+        return put(key, mapped, true);
+  }
+
+  bool remove(const key_type& key)
+  {
+        EpochReclamation::Guard guard;
+        Node* preds[MAX_LEVEL];
+        Node* succs[MAX_LEVEL];
+        if(!findPosition(key, preds, succs))
+            return false;
+
+        Node* node = succs[0];
+        for(int level = node->height - 1; level > 0; level--)
+            node->links()[level].mark();
+        if(!node->links()[0].mark())
+            return false;//uprzedzil nas inny watek
+
+        counter.fetch_sub(1, std::memory_order_relaxed);
+        findPosition(key, preds, succs);//fizycznie odpina wezel ze wszystkich poziomow
+        release(node);
+        return true;
+  }
+
+  const_iterator begin() const
+  {
+        const_iterator result(this);
+        result.moveTo(nextLive(head[0].pointer()));
+        return result;
+  }
+
+  const_iterator end() const
+  {
+        return const_iterator(this);
+  }
+
+  const_iterator cbegin() const
+  {
+        return begin();
+  }
+
+  const_iterator cend() const
+  {
+        return end();
+  }
+
+private:
+
+  Link& linkOf(Node* pred, int level) const
+  {
+      return pred == nullptr ? head[level] : pred->links()[level];
+  }
+
+  // wysokosc z rozkladu geometrycznego z p = 1/2; generator osobny dla kazdego watku
+  static int randomHeight()
+  {
+      static thread_local std::uint32_t state =
+          static_cast<std::uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+
+      std::uint32_t bits = state;
+      int height = 1;
+      while((bits & 1) == 0 && height < MAX_LEVEL)
+      {
+          height++;
+          bits >>= 1;
+      }
+      return height;
+  }
+
+  void raiseLevels(int height)
+  {
+      int current = levels.load(std::memory_order_relaxed);
+      while(current < height && !levels.compare_exchange_weak(current, height, std::memory_order_relaxed))
+      {}
+  }
+
+  // pomija oznaczone wezly, nikogo nie odpina - czytelnicy nie pisza do wspolnej pamieci
+  Node* lowerBoundNode(const key_type& key) const
+  {
+      Node* pred = nullptr;
+      Node* curr = nullptr;
+      for(int level = levels.load(std::memory_order_relaxed) - 1; level >= 0; level--)
+      {
+          curr = linkOf(pred, level).pointer();
+          while(curr != nullptr)
+          {
+              bool marked;
+              Node* succ = curr->links()[level].get(marked);
+              if(!marked)
+              {
+                  if(!(curr->key < key))
+                      break;
+                  pred = curr;
+              }
+              curr = succ;
+          }
+      }
+      return curr;
+  }
+
+  Node* findNode(const key_type& key) const
+  {
+      Node* node = lowerBoundNode(key);
+      return (node != nullptr && !(key < node->key)) ? node : nullptr;
+  }
+
+  // ostatni zywy wezel z kluczem < key; dla bound == nullptr ostatni w ogole
+  Node* lastBefore(const Node* bound) const
+  {
+      Node* pred = nullptr;
+      for(int level = levels.load(std::memory_order_relaxed) - 1; level >= 0; level--)
+      {
+          Node* curr = linkOf(pred, level).pointer();
+          while(curr != nullptr)
+          {
+              bool marked;
+              Node* succ = curr->links()[level].get(marked);
+              if(!marked)
+              {
+                  if(bound != nullptr && !(curr->key < bound->key))
+                      break;
+                  pred = curr;
+              }
+              curr = succ;
+          }
+      }
+      return pred;
+  }
+
+  static Node* nextLive(Node* node)
+  {
+      while(node != nullptr && node->links()[0].isMarked())
+          node = node->links()[0].pointer();
+      return node;
+  }
+
+  // poprzednicy i nastepcy key na kazdym uzywanym poziomie; po drodze odpina oznaczone wezly.
+  // Poziom wezla nigdy nie przekracza levels, bo wstawiajacy podnosi je przed szukaniem miejsca.
+  bool findPosition(const key_type& key, Node** preds, Node** succs) const
+  {
+      while(!tryFindPosition(key, preds, succs))
+      {}
+      return succs[0] != nullptr && !(key < succs[0]->key);
+  }
+
+  // false, gdy poprzednik zmienil sie w trakcie odpinania - trzeba zaczac od glowy
+  bool tryFindPosition(const key_type& key, Node** preds, Node** succs) const
+  {
+      Node* pred = nullptr;
+      for(int level = levels.load(std::memory_order_relaxed) - 1; level >= 0; level--)
+      {
+          Node* curr = linkOf(pred, level).pointer();
+          while(curr != nullptr)
+          {
+              bool marked;
+              Node* succ = curr->links()[level].get(marked);
+              if(marked)
+              {
+                  if(!linkOf(pred, level).compareAndSet(curr, succ))
+                      return false;
+                  curr = succ;
+                  continue;
+              }
+              if(!(curr->key < key))
+                  break;
+              pred = curr;
+              curr = succ;
+          }
+          preds[level] = pred;
+          succs[level] = curr;
+      }
+      return true;
+  }
+
+  bool put(const key_type& key, const mapped_type& mapped, bool assign)
+  {
+      EpochReclamation::Guard guard;
+      Node* preds[MAX_LEVEL];
+      Node* succs[MAX_LEVEL];
+      Node* node = nullptr;
+      const int height = randomHeight();
+      raiseLevels(height);
+      while(true)
+      {
+          if(findPosition(key, preds, succs))
+          {
+              if(node != nullptr)
+                  Node::destroy(node);//nikt go nie widzial
+              if(assign)
+                  replaceItem(succs[0], key, mapped);
+              return false;
+          }
+
+          if(node == nullptr)
+              node = Node::create(key, mapped, height);
+          for(int level = 0; level < node->height; level++)
+              node->links()[level].store(succs[level]);
+          if(linkOf(preds[0], 0).compareAndSet(succs[0], node))
+              break;
+      }
+
+      counter.fetch_add(1, std::memory_order_relaxed);
+      linkUpperLevels(node, preds, succs);
+      if(node->links()[0].isMarked())
+          findPosition(key, preds, succs);//usuniety w trakcie - odpinamy to, co zdazylismy doczepic
+      release(node);
+      return true;
+  }
+
+  // wezel jest juz w mapie (poziom 0); wyzsze poziomy sa tylko skrotami
+  void linkUpperLevels(Node* node, Node** preds, Node** succs)
+  {
+      for(int level = 1; level < node->height; level++)
+      {
+          while(true)
+          {
+              bool marked;
+              Node* next = node->links()[level].get(marked);
+              if(marked)
+                  return;
+              if(next != succs[level] && !node->links()[level].compareAndSet(next, succs[level]))
+                  continue;
+              if(linkOf(preds[level], level).compareAndSet(succs[level], node))
+                  break;
+              findPosition(node->key, preds, succs);
+              if(succs[0] != node)
+                  return;
+          }
+      }
+  }
+
+  void replaceItem(Node* node, const key_type& key, const mapped_type& mapped)
+  {
+      const value_type* item = new value_type(key, mapped);
+      EpochReclamation::instance().retire(const_cast<value_type*>(node->item.exchange(item)));
+  }
+
+  void release(Node* node)
+  {
+      if(node->owners.fetch_sub(1) == 1)
+          EpochReclamation::instance().retire(node, &Node::destroy);
+  }
+};
+
+template <typename KeyType, typename ValueType>
+class ConcurrentSkipListMap<KeyType, ValueType>::ValueReference
+{
+public:
+  ValueReference(ConcurrentSkipListMap& map, const key_type& key): map(map), key(key)
+  {}
+
+  ValueReference& operator=(const mapped_type& mapped)
+  {
+    map.insertOrAssign(key, mapped);
+    return *this;
+  }
+
+  ValueReference& operator=(const ValueReference& other)
+  {
+    return *this = static_cast<mapped_type>(other);
+  }
+
+  operator mapped_type() const
+  {
+    while(true)
+    {
+        map.insert(key, mapped_type());
+        EpochReclamation::Guard guard;
+        Node* node = map.findNode(key);
+        if(node != nullptr)
+            return node->item.load()->second;
+    }
+  }
+
+private:
+  ConcurrentSkipListMap& map;
+  const key_type key;
+};
+
+template <typename KeyType, typename ValueType>
+class ConcurrentSkipListMap<KeyType, ValueType>::ConstIterator
+{
+public:
+  using reference = typename ConcurrentSkipListMap::const_reference;
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename ConcurrentSkipListMap::value_type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const typename ConcurrentSkipListMap::value_type*;
+
+private:
+  friend class ConcurrentSkipListMap;
+
+  EpochReclamation::Guard guard;//trzyma przy zyciu wezel i pare, na ktore wskazuje iterator
+  const ConcurrentSkipListMap* map;
+  Node* node;
+  const value_type* item;//wartosc z chwili wejscia na wezel
+
+  explicit ConstIterator(const ConcurrentSkipListMap* map): map(map), node(nullptr), item(nullptr)
+  {}
+
+  void moveTo(Node* target)
+  {
+    node = target;
+    item = target != nullptr ? target->item.load() : nullptr;
+  }
+
+public:
+  ConstIterator(const ConstIterator& other) = default;
+  ConstIterator& operator=(const ConstIterator& other) = default;
+
+  ConstIterator& operator++()
+  {
+    if(node == nullptr)
+        throw std::out_of_range("operator++ out of range");
+    moveTo(nextLive(node->links()[0].pointer()));
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    ConstIterator result = *this;
+    operator++();
+    return result;
+  }
+
+  // bez wskaznikow wstecz - poprzednik szukany jest od glowy w O(log n)
+  ConstIterator& operator--()
+  {
+    Node* previous = map->lastBefore(node);
+    if(previous == nullptr)
+        throw std::out_of_range("operator-- out of range");
+    moveTo(previous);
+    return *this;
+  }
+
+  ConstIterator operator--(int)
+  {
+    ConstIterator result = *this;
+    operator--();
+    return result;
+  }
+
+  reference operator*() const
+  {
+    if(node == nullptr)
+        throw std::out_of_range("operator*() out_of_range");
+    return *item;
+  }
+
+  pointer operator->() const
+  {
+    return &this->operator*();
+  }
+
+  bool operator==(const ConstIterator& other) const
+  {
+    return map == other.map && node == other.node;
+  }
+
+  bool operator!=(const ConstIterator& other) const
+  {
+    return !(*this == other);
+  }
+};
+
+}
+
+#endif /* AISDI_MAPS_CONCURRENTSKIPLISTMAP_H */
@@ -0,0 +1,265 @@
+#include <ConcurrentSkipListMap.h>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedKeyTypes = boost::mpl::list<std::int32_t, std::uint64_t>;
+
+template <typename K>
+using Map = aisdi::ConcurrentSkipListMap<K, std::string>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(ConcurrentSkipListMapsTests)
+
+template <typename K>
+void thenMapContainsItems(const Map<K>& map,
+                          const std::map<K, std::string>& expected)
+{
+  BOOST_CHECK_EQUAL(map.getSize(), expected.size());
+
+  auto it = begin(map);
+  for (const auto& item : expected)
+  {
+    BOOST_REQUIRE_MESSAGE(it != end(map), "Missing required item with key: " << item.first);
+    BOOST_CHECK_EQUAL(it->first, item.first);
+    BOOST_CHECK_EQUAL(it->second, item.second);
+    ++it;
+  }
+  BOOST_CHECK(it == end(map));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map;
+
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(begin(map) == end(map));
+  BOOST_CHECK_THROW(--end(map), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInitializingFromListOfPairs_ThenItemsAreInOrder,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map = { { 42, "Alice" }, { 27, "Bob" }, { 99, "Chuck" } };
+
+  thenMapContainsItems(map, { { 27, "Bob" }, { 42, "Alice" }, { 99, "Chuck" } });
+  BOOST_CHECK_EQUAL(map.valueOf(42), "Alice");
+  BOOST_CHECK_THROW(map.valueOf(43), std::out_of_range);
+  BOOST_CHECK(map.find(43) == end(map));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenUsingIndexOperator_ThenItemsAreAddedOrAssigned,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+
+  map[42] = "Alice";
+  map[42] = "Bob";
+  const std::string missing = map[27];
+
+  BOOST_CHECK(missing.empty());
+  thenMapContainsItems(map, { { 27, "" }, { 42, "Bob" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenInsertingExistingKey_ThenOnlyInsertOrAssignChangesValue,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" } };
+
+  BOOST_CHECK(!map.insert(42, "Bob"));
+  BOOST_CHECK_EQUAL(map.valueOf(42), "Alice");
+  BOOST_CHECK(!map.insertOrAssign(42, "Bob"));
+  BOOST_CHECK_EQUAL(map.valueOf(42), "Bob");
+  BOOST_CHECK(map.insert(43, "Chuck"));
+  BOOST_CHECK_EQUAL(map.getSize(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenValueIsReplaced_ThenIteratorKeepsOldValue,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 1, "a" }, { 2, "b" } };
+
+  auto it = map.find(1);
+  map.insertOrAssign(1, "c");
+  map.remove(2);
+
+  BOOST_CHECK_EQUAL(it->second, "a");
+  BOOST_CHECK(++it == end(map));
+  BOOST_CHECK_EQUAL(map.find(1)->second, "c");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenRemovingKey_ThenItemIsRemoved,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  BOOST_CHECK(map.remove(27));
+  BOOST_CHECK(!map.remove(27));
+  BOOST_CHECK_EQUAL(map.getSize(), 1u);
+  BOOST_CHECK(!map.contains(27));
+  BOOST_CHECK(map.contains(42));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenMovingBothWays_ThenItemsAreVisitedInOrder,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (K i = 0; i < 100; ++i)
+    map.insert(i * 2, "x");
+
+  auto it = map.find(50);
+  BOOST_CHECK_EQUAL((++it)->first, K{52});
+  BOOST_CHECK_EQUAL((--it)->first, K{50});
+  BOOST_CHECK_EQUAL((--it)->first, K{48});
+  BOOST_CHECK_EQUAL(map.lowerBound(51)->first, K{52});
+  BOOST_CHECK(map.lowerBound(199) == end(map));
+
+  K expected = 200;
+  for (auto back = end(map); back != begin(map);)
+  {
+    --back;
+    expected -= 2;
+    BOOST_CHECK_EQUAL(back->first, expected);
+  }
+  BOOST_CHECK_THROW(--begin(map), std::out_of_range);
+  BOOST_CHECK_THROW(++end(map), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenMixingInsertsAndRemovals_ThenItMatchesStdMap,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  std::uint32_t seed = 12345;
+
+  for (int i = 0; i < 20000; ++i)
+  {
+    seed = seed * 1103515245u + 12345u;
+    const K key = static_cast<K>((seed >> 8) % 2000);
+    if ((seed >> 4) % 3 == 0)
+    {
+      BOOST_CHECK_EQUAL(map.remove(key), expected.erase(key) == 1);
+    }
+    else
+    {
+      map[key] = std::to_string(i);
+      expected[key] = std::to_string(i);
+    }
+  }
+
+  thenMapContainsItems(map, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyThreads_WhenInsertingDisjointKeys_ThenAllItemsAreInOrder,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&map, t]() {
+      for (K i = 0; i < 5000; ++i)
+        map.insert(static_cast<K>(i * 4 + t), "x");
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  BOOST_CHECK_EQUAL(map.getSize(), 20000u);
+  K expected = 0;
+  for (const auto& item : map)
+    BOOST_REQUIRE_EQUAL(item.first, expected++);
+  BOOST_CHECK_EQUAL(expected, K{20000});
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenThreadsRemovingSameKeys_WhenRunningConcurrently_ThenEachKeyIsRemovedOnce,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (K i = 0; i < 10000; ++i)
+    map.insert(i, "x");
+
+  std::atomic<int> removed(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&map, &removed]() {
+      for (K i = 0; i < 10000; ++i)
+        if (map.remove(i))
+          ++removed;
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  BOOST_CHECK_EQUAL(removed.load(), 10000);
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(begin(map) == end(map));
+}
+
+BOOST_AUTO_TEST_CASE(GivenReadersAndWriters_WhenRunningConcurrently_ThenIterationStaysOrderedAndStableKeysStay)
+{
+  aisdi::ConcurrentSkipListMap<int, int> map;
+  for (int i = 0; i < 1000; ++i)
+    map.insert(i * 2, i * 2);
+
+  std::atomic<bool> done(false);
+  std::atomic<int> failures(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; ++t)
+    threads.emplace_back([&map, t]() {
+      for (int round = 0; round < 20; ++round)
+        for (int i = t; i < 1000; i += 2)
+        {
+          map.insert(i * 2 + 1, -1);
+          map.insertOrAssign(i * 2 + 1, i * 2 + 1);
+          map.remove(i * 2 + 1);
+        }
+    });
+  for (int t = 0; t < 2; ++t)
+    threads.emplace_back([&map, &done, &failures]() {
+      while (!done)
+      {
+        int previous = -1;
+        int stable = 0;
+        for (const auto& item : map)
+        {
+          if (item.first <= previous || (item.second != item.first && item.second != -1))
+            ++failures;
+          if (item.first % 2 == 0)
+            ++stable;
+          previous = item.first;
+        }
+        if (stable != 1000)
+          ++failures;
+      }
+    });
+  for (int t = 0; t < 2; ++t)
+    threads[t].join();
+  done = true;
+  for (std::size_t t = 2; t < threads.size(); ++t)
+    threads[t].join();
+
+  BOOST_CHECK_EQUAL(failures.load(), 0);
+  BOOST_CHECK_EQUAL(map.getSize(), 1000u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
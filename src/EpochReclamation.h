@@ -0,0 +1,264 @@
+#ifndef AISDI_MAPS_EPOCHRECLAMATION_H
+#define AISDI_MAPS_EPOCHRECLAMATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace aisdi
+{
+
+// Odzyskiwanie pamieci oparte na epokach (Fraser) dla struktur bez blokad. Watek, ktory czyta
+// wspolne wskazniki, trzyma Guard; obiekt odpiety od struktury trafia do retire() i jest
+// zwalniany dopiero, gdy globalna epoka przesunie sie o dwa od chwili odpiecia - wtedy kazdy
+// przypiety watek wszedl do sekcji juz po odpieciu i nie mogl go zobaczyc.
+// Jedna domena na proces; rekord watku wraca do puli, gdy watek sie konczy.
+class EpochReclamation
+{
+public:
+  class Guard;
+
+  static const std::size_t COLLECT_INTERVAL = 64;
+
+  static EpochReclamation& instance()
+  {
+      static EpochReclamation domain;
+      return domain;
+  }
+
+  EpochReclamation(const EpochReclamation&) = delete;
+  EpochReclamation& operator=(const EpochReclamation&) = delete;
+
+  // wywolywany na koncu programu, gdy zaden watek nie korzysta juz z domeny
+  ~EpochReclamation()
+  {
+      Record* record = records.load();
+      while(record != nullptr)
+      {
+          Record* next = record->next;
+          freeAll(record->retired);
+          delete record;
+          record = next;
+      }
+      freeAll(orphans);
+  }
+
+  // obiekt musi byc juz nieosiagalny dla nowych czytelnikow; deleter nie moze wolac retire()
+  void retire(void* pointer, void (*deleter)(void*))
+  {
+      Record& record = localRecord();
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      record.retired.push_back(Retired{ pointer, deleter, global_epoch.load(std::memory_order_relaxed) });
+      if(record.retired.size() % COLLECT_INTERVAL == 0)
+          collect(record);
+  }
+
+  template <typename T>
+  void retire(T* pointer)
+  {
+      retire(pointer, &deleteObject<T>);
+  }
+
+  // probuje przesunac epoke i zwalnia wszystko, co juz mozna; zwraca liczbe zwolnionych obiektow
+  std::size_t collect()
+  {
+      return collect(localRecord());
+  }
+
+  std::uint64_t epoch() const
+  {
+      return global_epoch.load();
+  }
+
+private:
+  struct Retired
+  {
+      void* pointer;
+      void (*deleter)(void*);
+      std::uint64_t epoch;
+  };
+
+  class Record
+  {
+  public:
+      std::atomic<std::uint64_t> state;//(epoka << 1) | 1, gdy watek jest przypiety, inaczej 0
+      std::atomic<bool> in_use;
+      Record* next;
+      unsigned nesting;
+      std::vector<Retired> retired;
+      char padding[64];//przypiecie pisze tylko do swojego rekordu - rekordy nie moga dzielic linii
+
+      Record(): state(0), in_use(true), next(nullptr), nesting(0){}
+  };
+
+  // rekord watku przypisany przy pierwszym uzyciu domeny i zwalniany przy jego koncu
+  class LocalHandle
+  {
+  public:
+      explicit LocalHandle(EpochReclamation& domain): domain(domain), record(domain.acquireRecord())
+      {}
+
+      ~LocalHandle()
+      {
+          domain.releaseRecord(*record);
+      }
+
+      LocalHandle(const LocalHandle&) = delete;
+      LocalHandle& operator=(const LocalHandle&) = delete;
+
+      EpochReclamation& domain;
+      Record* record;
+  };
+
+  std::atomic<std::uint64_t> global_epoch;
+  std::atomic<Record*> records;
+  std::mutex orphan_lock;
+  std::vector<Retired> orphans;//obiekty po watkach, ktore sie zakonczyly
+
+  EpochReclamation(): global_epoch(0), records(nullptr)
+  {}
+
+  template <typename T>
+  static void deleteObject(void* pointer)
+  {
+      delete static_cast<T*>(pointer);
+  }
+
+  static void freeAll(std::vector<Retired>& list)
+  {
+      for(const Retired& item : list)
+          item.deleter(item.pointer);
+      list.clear();
+  }
+
+  static std::size_t freeExpired(std::vector<Retired>& list, std::uint64_t epoch)
+  {
+      std::size_t kept = 0;
+      for(std::size_t i = 0; i < list.size(); i++)
+      {
+          if(list[i].epoch + 2 <= epoch)
+              list[i].deleter(list[i].pointer);
+          else
+              list[kept++] = list[i];
+      }
+      const std::size_t freed = list.size() - kept;
+      list.resize(kept);
+      return freed;
+  }
+
+  Record& localRecord()
+  {
+      static thread_local LocalHandle handle(*this);
+      return *handle.record;
+  }
+
+  Record* acquireRecord()
+  {
+      for(Record* record = records.load(std::memory_order_acquire); record != nullptr; record = record->next)
+      {
+          bool expected = false;
+          if(!record->in_use.load(std::memory_order_relaxed)
+             && record->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+              return record;
+      }
+
+      Record* record = new Record();
+      record->next = records.load(std::memory_order_relaxed);
+      while(!records.compare_exchange_weak(record->next, record, std::memory_order_release, std::memory_order_relaxed))
+      {}
+      return record;
+  }
+
+  void releaseRecord(Record& record)
+  {
+      record.state.store(0, std::memory_order_release);
+      {
+          std::lock_guard<std::mutex> guard(orphan_lock);
+          orphans.insert(orphans.end(), record.retired.begin(), record.retired.end());
+      }
+      record.retired.clear();
+      record.in_use.store(false, std::memory_order_release);
+  }
+
+  void pin(Record& record)
+  {
+      if(record.nesting++ != 0)
+          return;
+      const std::uint64_t epoch = global_epoch.load(std::memory_order_relaxed);
+      record.state.store((epoch << 1) | 1, std::memory_order_release);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  void unpin(Record& record)
+  {
+      if(--record.nesting == 0)
+          record.state.store(0, std::memory_order_release);
+  }
+
+  // epoka rosnie, gdy kazdy przypiety watek widzial juz biezaca
+  bool tryAdvance()
+  {
+      std::uint64_t epoch = global_epoch.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      for(Record* record = records.load(std::memory_order_acquire); record != nullptr; record = record->next)
+      {
+          // acquire: wszystko, co watek przeczytal przed odpieciem, dzieje sie przed zwolnieniem
+          const std::uint64_t state = record->state.load(std::memory_order_acquire);
+          if((state & 1) != 0 && (state >> 1) != epoch)
+              return false;
+      }
+      return global_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel, std::memory_order_relaxed);
+  }
+
+  std::size_t collect(Record& record)
+  {
+      tryAdvance();
+      const std::uint64_t epoch = global_epoch.load(std::memory_order_acquire);
+      std::size_t freed = freeExpired(record.retired, epoch);
+      std::unique_lock<std::mutex> guard(orphan_lock, std::try_to_lock);
+      if(guard.owns_lock())
+          freed += freeExpired(orphans, epoch);
+      return freed;
+  }
+};
+
+// Przypina biezacy watek na czas zycia obiektu; moze byc zagniezdzony. Obiekt nalezy
+// do watku, ktory go utworzyl - nie wolno go niszczyc w innym watku.
+class EpochReclamation::Guard
+{
+public:
+  Guard(): record(&EpochReclamation::instance().localRecord())
+  {
+      EpochReclamation::instance().pin(*record);
+  }
+
+  Guard(const Guard& other): record(other.record)
+  {
+      EpochReclamation::instance().pin(*record);
+  }
+
+  Guard& operator=(const Guard& other)
+  {
+      if(record != other.record)
+      {
+          EpochReclamation::instance().pin(*other.record);
+          EpochReclamation::instance().unpin(*record);
+          record = other.record;
+      }
+      return *this;
+  }
+
+  ~Guard()
+  {
+      EpochReclamation::instance().unpin(*record);
+  }
+
+private:
+  Record* record;
+};
+
+}
+
+#endif /* AISDI_MAPS_EPOCHRECLAMATION_H */
@@ -0,0 +1,97 @@
+#include <EpochReclamation.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+
+std::atomic<int> deleted(0);
+
+void countDeletion(void* pointer)
+{
+  delete static_cast<int*>(pointer);
+  ++deleted;
+}
+
+// kilka prob wystarcza, gdy nikt nie trzyma przypiecia
+void collectUntil(int expected)
+{
+  auto& domain = aisdi::EpochReclamation::instance();
+  for (int i = 0; i < 100 && deleted.load() < expected; ++i)
+    domain.collect();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(EpochReclamationTests)
+
+BOOST_AUTO_TEST_CASE(GivenPinnedThread_WhenObjectIsRetired_ThenItIsFreedOnlyAfterUnpinning)
+{
+  auto& domain = aisdi::EpochReclamation::instance();
+  deleted = 0;
+
+  {
+    aisdi::EpochReclamation::Guard guard;
+    domain.retire(new int(1), &countDeletion);
+    for (int i = 0; i < 10; ++i)
+      domain.collect();
+    BOOST_CHECK_EQUAL(deleted.load(), 0);
+  }
+
+  collectUntil(1);
+  BOOST_CHECK_EQUAL(deleted.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenReaderInOtherThread_WhenItStaysPinned_ThenEpochCannotMoveTwice)
+{
+  auto& domain = aisdi::EpochReclamation::instance();
+  std::atomic<bool> pinned(false);
+  std::atomic<bool> release(false);
+
+  std::thread reader([&pinned, &release]() {
+    aisdi::EpochReclamation::Guard guard;
+    pinned = true;
+    while (!release)
+      std::this_thread::yield();
+  });
+  while (!pinned)
+    std::this_thread::yield();
+
+  const auto start = domain.epoch();
+  for (int i = 0; i < 10; ++i)
+    domain.collect();
+  BOOST_CHECK_LE(domain.epoch(), start + 1);
+
+  release = true;
+  reader.join();
+  for (int i = 0; i < 10; ++i)
+    domain.collect();
+  BOOST_CHECK_GE(domain.epoch(), start + 2);
+}
+
+BOOST_AUTO_TEST_CASE(GivenManyThreads_WhenRetiringObjects_ThenAllAreFreedAfterThreadsEnd)
+{
+  deleted = 0;
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([]() {
+      auto& domain = aisdi::EpochReclamation::instance();
+      for (int i = 0; i < 1000; ++i)
+      {
+        aisdi::EpochReclamation::Guard guard;
+        domain.retire(new int(i), &countDeletion);
+      }
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  collectUntil(4000);
+  BOOST_CHECK_EQUAL(deleted.load(), 4000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
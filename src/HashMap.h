@@ -1,15 +1,49 @@
 #ifndef AISDI_MAPS_HASHMAP_H
 #define AISDI_MAPS_HASHMAP_H
 
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#include "PoolAllocator.h"
+#include "ThreadPool.h"
 
 namespace aisdi
 {
 
-template <typename KeyType, typename ValueType>
+namespace detail
+{
+
+template <typename>
+struct VoidType
+{
+  using type = void;
+};
+
+// funkcja skrotu deklarujaca "using is_avalanching = void;" dobrze miesza bity sama,
+// wiec kubelek wybierany jest maska zamiast dodatkowego mieszania Fibonacciego
+template <typename Hash, typename = void>
+struct IsAvalanching : std::false_type
+{};
+
+template <typename Hash>
+struct IsAvalanching<Hash, typename VoidType<typename Hash::is_avalanching>::type> : std::true_type
+{};
+
+}
+
+template <typename KeyType, typename ValueType,
+          typename Hash = std::hash<KeyType>,
+          typename KeyEqual = std::equal_to<KeyType>,
+          typename Allocator = PoolAllocator<std::pair<const KeyType, ValueType>>>
 class HashMap
 {
 
@@ -20,6 +54,9 @@ class HashMap
       using size_type = std::size_t;
       using reference = value_type&;
       using const_reference = const value_type&;
+      using hasher = Hash;
+      using key_equal = KeyEqual;
+      using allocator_type = Allocator;
 
       class ConstIterator;
       class Iterator;
@@ -31,75 +68,99 @@ private:
          public:
         HashNode *next;
         HashNode *prev;
+        size_type hash;//pelny skrot klucza, liczony tylko raz
         value_type datapair;
 
-        HashNode(key_type key, mapped_type mapped):
-            next(nullptr), prev(nullptr), datapair(std::make_pair(key,mapped)){}
-
-        HashNode(key_type key, mapped_type mapped, HashNode* prev):
-            next(nullptr), prev(nullptr), datapair(std::make_pair(key,mapped))
-            {
-                this->prev = prev;
-            }
+        HashNode(key_type key, mapped_type mapped, size_type hash):
+            next(nullptr), prev(nullptr), hash(hash), datapair(std::make_pair(key,mapped)){}
 
         ~HashNode()
             {}
     };
-    const size_type TABLE_SIZE = 1000;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<HashNode>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    static const size_type DEFAULT_TABLE_SIZE = 16;
+    NodeAllocator node_alloc;
+    hasher hash_function;
+    key_equal key_eq;
     HashNode** hashtable;
+    size_type table_size;//zawsze potega dwojki (albo 0 po przeniesieniu)
+    unsigned bucket_shift;
     size_type counter;
+    float max_load_factor;
+    std::vector<std::uint64_t> occupancy;//bit na kazdy niepusty kubelek
+    size_type first_bucket;//najmniejszy niepusty kubelek albo table_size
 
 public:
 
-  HashMap(): hashtable(nullptr), counter(0)
+  HashMap(): HashMap(DEFAULT_TABLE_SIZE)
+  {}
+
+  explicit HashMap(size_type bucketCount, const hasher& hash = hasher(), const key_equal& equal = key_equal(),
+                   const Allocator& allocator = Allocator()):
+      node_alloc(allocator), hash_function(hash), key_eq(equal), hashtable(nullptr),
+      table_size(roundToPowerOfTwo(bucketCount)), bucket_shift(shiftFor(table_size)), counter(0), max_load_factor(1.0f),
+      occupancy(wordCount(table_size), 0), first_bucket(table_size)
   {
-        hashtable = new HashNode* [TABLE_SIZE];
-            for (size_type i = 0; i < TABLE_SIZE; i++)
+        hashtable = new HashNode* [table_size];
+            for (size_type i = 0; i < table_size; i++)
                 hashtable[i] = nullptr;//inicjalizacja nullem
   }
 
   HashMap(std::initializer_list<value_type> list):HashMap()
   {
-        for(auto it = list.begin(); it!= list.end(); it++)
-            operator[]((*it).first) = (*it).second;
+        insert(list.begin(), list.end());
   }
 
-  HashMap(const HashMap& other):HashMap()
+  template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+  HashMap(InputIt first, InputIt last, size_type bucketCount = 0, const hasher& hash = hasher(),
+          const key_equal& equal = key_equal(), const Allocator& allocator = Allocator()):
+      HashMap(bucketCount, hash, equal, allocator)
   {
-        for(auto it = other.begin(); it!= other.end(); it++)
-            operator[]((*it).first) = (*it).second;
+        insert(first, last);
   }
 
-  HashMap(HashMap&& other):HashMap()//do edycji
+  HashMap(const HashMap& other):HashMap(other.table_size, other.hash_function, other.key_eq,
+                                        NodeTraits::select_on_container_copy_construction(other.node_alloc))
   {
-        for(auto it = other.begin(); it!= other.end(); it++)
-            operator[]((*it).first) = (*it).second;
+        max_load_factor = other.max_load_factor;
+        copyNodes(other);
+  }
 
-        other.eraseHashMap();
-    }
+  // przejmuje tablice i wezly; other zostaje pusta mapa bez tablicy kubelkow
+  HashMap(HashMap&& other) noexcept:
+      node_alloc(std::move(other.node_alloc)), hash_function(other.hash_function), key_eq(other.key_eq),
+      hashtable(other.hashtable), table_size(other.table_size), bucket_shift(other.bucket_shift),
+      counter(other.counter), max_load_factor(other.max_load_factor),
+      occupancy(std::move(other.occupancy)), first_bucket(other.first_bucket)
+  {
+        other.hashtable = nullptr;
+        other.table_size = 0;
+        other.counter = 0;
+        other.occupancy.clear();
+        other.first_bucket = 0;
+  }
 
   HashMap& operator=(const HashMap& other)
   {
         if(this!= &other)
             {
                 eraseHashMap();
-
-                for(auto it = other.begin(); it!= other.end(); it++)
-                    operator[]((*it).first) = (*it).second;
+                max_load_factor = other.max_load_factor;
+                if(other.table_size != 0)
+                    rehash(other.table_size);
+                copyNodes(other);
             }
         return *this;
   }
 
-  HashMap& operator=(HashMap&& other)
+  HashMap& operator=(HashMap&& other) noexcept
   {
             if(this!= &other)
             {
-                eraseHashMap();
-
-                for(auto it = other.begin(); it!= other.end(); it++)
-                    operator[]((*it).first)= (*it).second;
-
-                other.eraseHashMap();
+                HashMap temp(std::move(other));
+                swap(temp);
             }
         return *this;
   }
@@ -110,6 +171,21 @@ public:
       delete[] hashtable;
   }
 
+  void swap(HashMap& other) noexcept
+  {
+        using std::swap;
+        swap(node_alloc, other.node_alloc);
+        swap(hash_function, other.hash_function);
+        swap(key_eq, other.key_eq);
+        swap(hashtable, other.hashtable);
+        swap(table_size, other.table_size);
+        swap(bucket_shift, other.bucket_shift);
+        swap(counter, other.counter);
+        swap(max_load_factor, other.max_load_factor);
+        occupancy.swap(other.occupancy);
+        swap(first_bucket, other.first_bucket);
+  }
+
   bool isEmpty() const
   {
         return counter == 0;
@@ -117,33 +193,25 @@ public:
 
   mapped_type& operator[](const key_type& key)
   {
-    HashNode* temp1 = findNode(key);
+    const size_type hash = hashKey(key);
+    HashNode* temp1 = findNode(key, hash);
 
         if(temp1 == nullptr)
         {
-            counter++;
-            temp1 = new HashNode(key, mapped_type());
+            if(counter + 1 > table_size * max_load_factor)
+                rehash(table_size > 0 ? table_size * 2 : DEFAULT_TABLE_SIZE);
 
-            if(hashtable[modHash(key)] != nullptr)
-                {
-                    HashNode* temp2 = hashtable[modHash(key)];
-                    while(temp2->next != nullptr)
-                        temp2 = temp2->next;
-                    temp2->next = temp1;
-                    temp1->prev = temp2;
-                }
+            temp1 = createNode(key, mapped_type(), hash);
+            counter++;
 
-            else
-                {
-                   hashtable[modHash(key)] = temp1;
-                }
+            linkNode(temp1, bucketOf(hash));
         }
     return temp1->datapair.second;
   }
 
   const mapped_type& valueOf(const key_type& key) const
   {
-        HashNode* temp = findNode(key);
+        HashNode* temp = findNode(key, hashKey(key));
         if(temp == nullptr)
             throw std::out_of_range("valueOf out of range error");
         return temp->datapair.second;
@@ -151,7 +219,7 @@ public:
 
   mapped_type& valueOf(const key_type& key)
   {
-        HashNode* temp = findNode(key);
+        HashNode* temp = findNode(key, hashKey(key));
         if(temp == nullptr)
             throw std::out_of_range("valueOf out of range error");
         return temp->datapair.second;
@@ -159,12 +227,16 @@ public:
 
   const_iterator find(const key_type& key) const
   {
-        return const_iterator(this, findNode(key), modHash(key));
+        const size_type hash = hashKey(key);
+        HashNode* node = findNode(key, hash);
+        return const_iterator(this, node, node != nullptr ? bucketOf(hash) : table_size);
   }
 
   iterator find(const key_type& key)
   {
-        return iterator(this, findNode(key), modHash(key));
+        const size_type hash = hashKey(key);
+        HashNode* node = findNode(key, hash);
+        return iterator(this, node, node != nullptr ? bucketOf(hash) : table_size);
   }
 
   void remove(const key_type& key)
@@ -177,15 +249,20 @@ public:
     if(it == end())
         throw std::out_of_range("remove out of range");
     if(it.curr_node->prev == nullptr)
-        hashtable[modHash(it.curr_node->datapair.first)] = it.curr_node->next;
+    {
+        const size_type index = bucketOf(it.curr_node->hash);
+        hashtable[index] = it.curr_node->next;
+        if(hashtable[index] == nullptr)
+            markEmpty(index);
+    }
     else
-        it.curr_node->prev->next = it.curr_node->prev;
+        it.curr_node->prev->next = it.curr_node->next;
 
     if(it.curr_node->next != nullptr)
-        it.curr_node->next->prev = it.curr_node->next;
+        it.curr_node->next->prev = it.curr_node->prev;
 
     it.curr_node->next = nullptr;
-    delete it.curr_node;
+    destroyNode(it.curr_node);
     counter--;
   }
 
@@ -194,15 +271,85 @@ public:
     return counter;
   }
 
+  size_type bucketCount() const
+  {
+    return table_size;
+  }
+
+  float loadFactor() const
+  {
+    return table_size == 0 ? 0.0f : static_cast<float>(counter) / table_size;
+  }
+
+  float maxLoadFactor() const
+  {
+    return max_load_factor;
+  }
+
+  void setMaxLoadFactor(float factor)
+  {
+    if(!(factor > 0.0f))
+        throw std::invalid_argument("max load factor must be positive");
+    max_load_factor = factor;
+    if(counter > table_size * max_load_factor)
+        rehash(table_size);
+  }
+
+  // przebudowuje tablice tak, by miala co najmniej bucketCount kubelkow
+  // i nie przekraczala maksymalnego wspolczynnika zapelnienia
+  void rehash(size_type bucketCount)
+  {
+    size_type minimal = static_cast<size_type>(std::ceil(counter / max_load_factor));
+    if(bucketCount < minimal)
+        bucketCount = minimal;
+    bucketCount = roundToPowerOfTwo(bucketCount);
+    if(bucketCount == table_size)
+        return;
+
+    HashNode** newtable = new HashNode* [bucketCount];
+    for(size_type i = 0; i < bucketCount; i++)
+        newtable[i] = nullptr;
+
+    std::vector<std::uint64_t> newoccupancy(wordCount(bucketCount), 0);
+
+    HashNode** oldtable = hashtable;
+    size_type oldsize = table_size;
+    size_type oldfirst = first_bucket;
+    hashtable = newtable;
+    table_size = bucketCount;
+    bucket_shift = shiftFor(table_size);
+    occupancy.swap(newoccupancy);
+    first_bucket = table_size;
+
+    for(size_type i = oldfirst; i < oldsize; i = nextBucket(newoccupancy, oldsize, i + 1))
+    {
+        HashNode* temp = oldtable[i];
+        while(temp != nullptr)
+        {
+            HashNode* next = temp->next;
+            temp->prev = nullptr;
+            linkNode(temp, bucketOf(temp->hash));
+            temp = next;
+        }
+    }
+    delete[] oldtable;
+  }
+
+  void reserve(size_type count)
+  {
+    rehash(static_cast<size_type>(std::ceil(count / max_load_factor)));
+  }
+
   bool operator==(const HashMap& other) const
   {
     if(other.counter != counter)
         return false;
 
-    auto it2 = other.begin();
-    for(auto it1 = begin(); it1!=end(); ++it1, ++it2)
+    // kolejnosc iteracji zalezy od liczby kubelkow, wiec porownujemy przez wyszukiwanie
+    for(auto it1 = begin(); it1!=end(); ++it1)
     {
-       if(*it1 != *it2)
+       HashNode* temp = other.findNode(it1->first, it1.curr_node->hash);
+       if(temp == nullptr || temp->datapair.second != it1->second)
         return false;
     }
     return true;
@@ -215,26 +362,26 @@ public:
 
   iterator begin()
   {
-    if(firstNode() == TABLE_SIZE)
+    if(first_bucket == table_size)
         return end();
-    return iterator (this, hashtable[firstNode()], firstNode());
+    return iterator (this, hashtable[first_bucket], first_bucket);
   }
 
   iterator end()
   {
-    return iterator(this, nullptr, TABLE_SIZE);
+    return iterator(this, nullptr, table_size);
   }
 
   const_iterator cbegin() const
   {
-    if(firstNode() == TABLE_SIZE)
+    if(first_bucket == table_size)
         return cend();
-    return const_iterator (this, hashtable[firstNode()], firstNode());
+    return const_iterator (this, hashtable[first_bucket], first_bucket);
   }
 
   const_iterator cend() const
   {
-    return const_iterator (this, nullptr, TABLE_SIZE);
+    return const_iterator (this, nullptr, table_size);
   }
 
   const_iterator begin() const
@@ -250,11 +397,19 @@ public:
 
   HashNode* findNode(const key_type& key) const
   {
-      HashNode* temp = hashtable [ modHash(key) ];
+      return findNode(key, hashKey(key));
+  }
+
+  HashNode* findNode(const key_type& key, size_type hash) const
+  {
+      if(table_size == 0)
+          return nullptr;
+
+      HashNode* temp = hashtable [ bucketOf(hash) ];
 
       while(temp != nullptr)
           {
-              if(temp->datapair.first == key)
+              if(temp->hash == hash && key_eq(temp->datapair.first, key))
                 {
                     return temp;
                 }
@@ -267,53 +422,373 @@ public:
   {
       if(counter != 0)
           {
-              for(size_type i = 0; i<TABLE_SIZE; i++)
+              for(size_type i = first_bucket; i<table_size; i = nextBucket(i + 1))
                   {
-                      delete hashtable[i];
+                      HashNode* temp = hashtable[i];
+                      while(temp != nullptr)
+                      {
+                          HashNode* next = temp->next;
+                          destroyNode(temp);
+                          temp = next;
+                      }
                       hashtable[i] = nullptr;
                   }
+              for(auto& word : occupancy)
+                  word = 0;
           }
       counter = 0;
+      first_bucket = table_size;
+  }
+
+
+
+  HashNode* createNode(const key_type& key, const mapped_type& mapped, size_type hash)
+  {
+      HashNode* node = NodeTraits::allocate(node_alloc, 1);
+      try
+      {
+          NodeTraits::construct(node_alloc, node, key, mapped, hash);
+      }
+      catch(...)
+      {
+          NodeTraits::deallocate(node_alloc, node, 1);
+          throw;
+      }
+      return node;
+  }
+
+  void destroyNode(HashNode* node)
+  {
+      NodeTraits::destroy(node_alloc, node);
+      NodeTraits::deallocate(node_alloc, node, 1);
+  }
+
+  void linkNode(HashNode* node, size_type index)
+  {
+      // nowy wezel na poczatek listy - nie trzeba przechodzic do jej konca
+      node->next = hashtable[index];
+      if(hashtable[index] != nullptr)
+          hashtable[index]->prev = node;
+      else
+          markOccupied(index);
+      hashtable[index] = node;
+  }
+
+  static size_type wordCount(size_type buckets)
+  {
+      return (buckets + 63) / 64;
+  }
+
+  static unsigned lowestBit(std::uint64_t word)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+      unsigned bit = 0;
+      while((word & 1u) == 0)
+      {
+          word >>= 1;
+          bit++;
+      }
+      return bit;
+#endif
+  }
+
+  static unsigned highestBit(std::uint64_t word)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+      return 63u - static_cast<unsigned>(__builtin_clzll(word));
+#else
+      unsigned bit = 63;
+      while((word & (std::uint64_t(1) << 63)) == 0)
+      {
+          word <<= 1;
+          bit--;
+      }
+      return bit;
+#endif
   }
 
+  void markOccupied(size_type index)
+  {
+      occupancy[index / 64] |= std::uint64_t(1) << (index % 64);
+      if(index < first_bucket)
+          first_bucket = index;
+  }
 
+  void markEmpty(size_type index)
+  {
+      occupancy[index / 64] &= ~(std::uint64_t(1) << (index % 64));
+      if(index == first_bucket)
+          first_bucket = nextBucket(index + 1);
+  }
 
-  size_type firstNode() const
+  // najblizszy niepusty kubelek >= from albo buckets, gdy takiego nie ma
+  static size_type nextBucket(const std::vector<std::uint64_t>& bits, size_type buckets, size_type from)
   {
-      size_type index = 0;
+      if(from >= buckets)
+          return buckets;
 
-        while(hashtable[index] == nullptr && index != TABLE_SIZE)
-            index++;
+      size_type word = from / 64;
+      std::uint64_t current = bits[word] & (~std::uint64_t(0) << (from % 64));
+      while(current == 0)
+      {
+          if(++word == bits.size())
+              return buckets;
+          current = bits[word];
+      }
+      return word * 64 + lowestBit(current);
+  }
+
+  size_type nextBucket(size_type from) const
+  {
+      return nextBucket(occupancy, table_size, from);
+  }
 
-        return index;
+  // najblizszy niepusty kubelek < before albo table_size, gdy takiego nie ma
+  size_type prevBucket(size_type before) const
+  {
+      if(before == 0)
+          return table_size;
+
+      size_type word = (before - 1) / 64;
+      const unsigned shift = static_cast<unsigned>(63 - (before - 1) % 64);
+      std::uint64_t current = occupancy[word] & (~std::uint64_t(0) >> shift);
+      while(current == 0)
+      {
+          if(word == 0)
+              return table_size;
+          current = occupancy[--word];
+      }
+      return word * 64 + highestBit(current);
+  }
+
+  size_type hashKey(const key_type& key) const
+  {
+      return hash_function(key);
+  }
+
+  // przesuniecie zamiast dzielenia; std::hash dla liczb to identycznosc, wiec skrot
+  // najpierw mieszamy mnozeniem Fibonacciego i bierzemy gorne bity
+  size_type bucketOf(size_type hash) const
+  {
+      if(detail::IsAvalanching<hasher>::value)
+          return hash & (table_size - 1);
+      return static_cast<size_type>((static_cast<std::uint64_t>(hash) * 11400714819323198485ull) >> bucket_shift);
+  }
 
+  static size_type roundToPowerOfTwo(size_type count)
+  {
+      size_type result = 2;
+      while(result < count)
+          result *= 2;
+      return result;
   }
 
-  size_type modHash(const key_type& key) const
+  static unsigned shiftFor(size_type buckets)
   {
-      return std::hash<key_type>()(key) % TABLE_SIZE;
+      unsigned shift = 64;
+      while(buckets > 1)
+      {
+          buckets /= 2;
+          shift--;
+      }
+      return shift;
   }
 
   void insert(key_type key, mapped_type mapped)
       {
           operator[](key) = mapped;
       }
+
+  // tablica jest powiekszana od razu o dlugosc zakresu (gdy da sie ja policzyc)
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last)
+      {
+          reserveFor(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+          for(; first != last; ++first)
+              operator[]((*first).first) = (*first).second;
+      }
+
+  // wywolujacy gwarantuje, ze klucze sa rozne i nie ma ich w mapie - duplikatow nie szukamy
+  template <typename InputIt>
+  void insertUnique(InputIt first, InputIt last)
+      {
+          insertUnique(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+      }
+
+  // wywoluje fn(para) dla kazdego elementu w watkach puli; kazde zadanie dostaje ciagly
+  // przedzial kubelkow. Kolejnosc wywolan jest dowolna, fn nie moze zmieniac mapy.
+  template <typename Function>
+  void parallelForEach(Function fn, ThreadPool& pool = ThreadPool::instance())
+      {
+          forEachInRanges(pool, [&fn](HashNode* node, size_type) { fn(node->datapair); });
+      }
+
+  template <typename Function>
+  void parallelForEach(Function fn, ThreadPool& pool = ThreadPool::instance()) const
+      {
+          forEachInRanges(pool, [&fn](const HashNode* node, size_type) { fn(static_cast<const value_type&>(node->datapair)); });
+      }
+
+  // combine(init, map(para), map(para), ...) po wszystkich elementach, jak std::accumulate;
+  // kolejnosc zalezy od kubelkow i watkow, wiec combine musi byc laczne i przemienne
+  template <typename T, typename MapFunction, typename Combine>
+  T parallelReduce(T init, MapFunction map, Combine combine, ThreadPool& pool = ThreadPool::instance()) const
+      {
+          std::vector<detail::PartialResult<T>> partial(rangeCount(pool), detail::PartialResult<T>(init));
+          forEachInRanges(pool, [&](const HashNode* node, size_type range) {
+              partial[range].add(map(static_cast<const value_type&>(node->datapair)), combine);
+          });
+
+          for(auto& item : partial)
+              if(item.filled)
+                  init = combine(std::move(init), std::move(item.value));
+          return init;
+      }
+
+private:
+  static const size_type PARTITION_THRESHOLD = 4096;
+
+  size_type rangeCount(const ThreadPool& pool) const
+  {
+      const size_type count = pool.splitCount();
+      return count < table_size ? count : (table_size > 0 ? table_size : 1);
+  }
+
+  // dzieli kubelki na rowne przedzialy; fn(wezel, numer przedzialu)
+  template <typename Function>
+  void forEachInRanges(ThreadPool& pool, const Function& fn) const
+  {
+      const size_type ranges = rangeCount(pool);
+      pool.parallelFor(ranges, [this, ranges, &fn](size_type range) {
+          const size_type last = table_size * (range + 1) / ranges;
+          for(size_type i = nextBucket(table_size * range / ranges); i < last; i = nextBucket(i + 1))
+              for(HashNode* temp = hashtable[i]; temp != nullptr; temp = temp->next)
+                  fn(temp, range);
+      });
+  }
+
+  static const unsigned PARTITION_BITS = 8;
+
+  template <typename InputIt>
+  void reserveFor(InputIt, InputIt, std::input_iterator_tag)
+  {}
+
+  template <typename ForwardIt>
+  void reserveFor(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+  {
+      reserve(counter + static_cast<size_type>(std::distance(first, last)));
+  }
+
+  void linkNew(const key_type& key, const mapped_type& mapped, size_type hash)
+  {
+      HashNode* node = createNode(key, mapped, hash);
+      linkNode(node, bucketOf(hash));
+      counter++;
+  }
+
+  template <typename InputIt>
+  void insertUnique(InputIt first, InputIt last, std::input_iterator_tag)
+  {
+      for(; first != last; ++first)
+      {
+          if(counter + 1 > table_size * max_load_factor)
+              rehash(table_size > 0 ? table_size * 2 : DEFAULT_TABLE_SIZE);
+          linkNew((*first).first, (*first).second, hashKey((*first).first));
+      }
+  }
+
+  // duze wejscie najpierw rozdzielamy (sortowanie przez zliczanie) wedlug najstarszych bitow
+  // numeru kubelka, wiec zapisy do tablicy i kolejne wezly z puli leza blisko siebie
+  template <typename ForwardIt>
+  void insertUnique(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+  {
+      const size_type count = static_cast<size_type>(std::distance(first, last));
+      reserve(counter + count);
+
+      if(count < PARTITION_THRESHOLD)
+      {
+          for(; first != last; ++first)
+              linkNew((*first).first, (*first).second, hashKey((*first).first));
+          return;
+      }
+
+      struct Pending
+      {
+          size_type hash;
+          ForwardIt item;
+      };
+
+      const unsigned tablebits = 64 - bucket_shift;
+      const unsigned bits = tablebits < PARTITION_BITS ? tablebits : PARTITION_BITS;
+      std::vector<size_type> hashes;
+      std::vector<size_type> offsets((size_type(1) << bits) + 1, 0);
+      hashes.reserve(count);
+      for(ForwardIt it = first; it != last; ++it)
+      {
+          hashes.push_back(hashKey((*it).first));
+          offsets[(bucketOf(hashes.back()) >> (tablebits - bits)) + 1]++;
+      }
+      for(size_type i = 1; i < offsets.size(); i++)
+          offsets[i] += offsets[i - 1];
+
+      std::vector<Pending> ordered(count, Pending{0, first});
+      size_type i = 0;
+      for(ForwardIt it = first; it != last; ++it, ++i)
+      {
+          size_type& slot = offsets[bucketOf(hashes[i]) >> (tablebits - bits)];
+          ordered[slot].hash = hashes[i];
+          ordered[slot].item = it;
+          slot++;
+      }
+
+      for(const Pending& pending : ordered)
+          linkNew((*pending.item).first, (*pending.item).second, pending.hash);
+  }
+
+  // kopiuje wezly do pustej mapy o tej samej liczbie kubelkow - bez liczenia skrotow
+  void copyNodes(const HashMap& other)
+  {
+      if(other.table_size != table_size)
+      {
+          reserve(other.counter);
+          for(auto it = other.begin(); it != other.end(); ++it)
+              linkNew(it->first, it->second, it.curr_node->hash);
+          return;
+      }
+      for(size_type i = other.first_bucket; i < other.table_size; i = other.nextBucket(i + 1))
+      {
+          for(HashNode* temp = other.hashtable[i]; temp != nullptr; temp = temp->next)
+          {
+              linkNode(createNode(temp->datapair.first, temp->datapair.second, temp->hash), i);
+              counter++;
+          }
+      }
+  }
 };
 
-template <typename KeyType, typename ValueType>
-class HashMap<KeyType, ValueType>::ConstIterator
+template <typename KeyType, typename ValueType, typename Hash, typename KeyEqual, typename Allocator>
+void swap(HashMap<KeyType, ValueType, Hash, KeyEqual, Allocator>& left, HashMap<KeyType, ValueType, Hash, KeyEqual, Allocator>& right) noexcept
+{
+  left.swap(right);
+}
+
+template <typename KeyType, typename ValueType, typename Hash, typename KeyEqual, typename Allocator>
+class HashMap<KeyType, ValueType, Hash, KeyEqual, Allocator>::ConstIterator
 {
 public:
   using reference = typename HashMap::const_reference;
   using iterator_category = std::bidirectional_iterator_tag;
   using value_type = typename HashMap::value_type;
+  using difference_type = std::ptrdiff_t;
   using pointer = const typename HashMap::value_type*;
 
 
     const HashMap* hashmap;
     HashNode* curr_node;
     size_type index;
-    friend void HashMap<KeyType, ValueType>::remove(const const_iterator&);
+    friend void HashMap<KeyType, ValueType, Hash, KeyEqual, Allocator>::remove(const const_iterator&);
 
 
     explicit ConstIterator(){};
@@ -321,7 +796,7 @@ public:
   ConstIterator(const HashMap *hashmap = nullptr, HashNode* node = nullptr, size_type index = 0): hashmap(hashmap), curr_node(node), index(index)
   {
     if(curr_node==nullptr && hashmap != nullptr)
-        this->index = hashmap->TABLE_SIZE;
+        this->index = hashmap->table_size;
   }
 
   ConstIterator(const ConstIterator& other)
@@ -338,12 +813,9 @@ public:
 
     else
     {
-        index++;
+        index = hashmap->nextBucket(index + 1);
 
-        while(hashmap->hashtable[index] == nullptr  && index != hashmap->TABLE_SIZE)
-            index++;
-
-        if(index != hashmap->TABLE_SIZE)
+        if(index != hashmap->table_size)
             curr_node = hashmap->hashtable[index];
 
         else
@@ -365,13 +837,11 @@ public:
         throw std::out_of_range("operator-- out of range");
     else if(curr_node == nullptr || curr_node == hashmap->hashtable[index])
         {
-            index--;
-            while(hashmap->hashtable[index] == nullptr && index > 0 )
-                index--;
-
-            if(index == 0 && hashmap->hashtable[index] == nullptr)
+            size_type previous = hashmap->prevBucket(index);
+            if(previous == hashmap->table_size)
                 throw std::out_of_range("operator-- out of range");
 
+            index = previous;
             curr_node = hashmap->hashtable[index];
 
             while (curr_node->next != nullptr)
@@ -417,8 +887,8 @@ public:
 
 };
 
-template <typename KeyType, typename ValueType>
-class HashMap<KeyType, ValueType>::Iterator : public HashMap<KeyType, ValueType>::ConstIterator
+template <typename KeyType, typename ValueType, typename Hash, typename KeyEqual, typename Allocator>
+class HashMap<KeyType, ValueType, Hash, KeyEqual, Allocator>::Iterator : public HashMap<KeyType, ValueType, Hash, KeyEqual, Allocator>::ConstIterator
 {
 public:
   using reference = typename HashMap::reference;
@@ -1,8 +1,11 @@
 #include <HashMap.h>
 
+#include <cctype>
 #include <cstdint>
 #include <string>
 #include <map>
+#include <type_traits>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -16,6 +19,45 @@ using Map = aisdi::HashMap<K, std::string>;
 using std::begin;
 using std::end;
 
+namespace
+{
+
+struct PointHash
+{
+  std::size_t operator()(const std::pair<int, int>& point) const
+  {
+    return std::hash<int>()(point.first) * 31 + std::hash<int>()(point.second);
+  }
+};
+
+struct CaseInsensitiveHash
+{
+  using is_avalanching = void;
+
+  std::size_t operator()(const std::string& text) const
+  {
+    std::string lower;
+    for (char c : text)
+      lower += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return std::hash<std::string>()(lower);
+  }
+};
+
+struct CaseInsensitiveEqual
+{
+  bool operator()(const std::string& left, const std::string& right) const
+  {
+    if (left.size() != right.size())
+      return false;
+    for (std::size_t i = 0; i < left.size(); ++i)
+      if (std::tolower(static_cast<unsigned char>(left[i])) != std::tolower(static_cast<unsigned char>(right[i])))
+        return false;
+    return true;
+  }
+};
+
+}
+
 BOOST_AUTO_TEST_SUITE(HashMapsTests)
 
 template <typename K>
@@ -591,6 +633,329 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoMapsWithDifferentKeys_WhenComparingThem_Th
   BOOST_CHECK(map != other);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapWithFewBuckets_WhenAddingManyItems_ThenTableGrowsAndKeepsItems,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(4);
+  std::map<K, std::string> expected;
+
+  for (K i = 0; i < 1000; ++i)
+  {
+    map[i] = std::to_string(i);
+    expected[i] = std::to_string(i);
+  }
+
+  BOOST_CHECK(map.bucketCount() > 4);
+  BOOST_CHECK(map.loadFactor() <= map.maxLoadFactor());
+  thenMapContainsItems(map, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenReserving_ThenInsertingDoesNotRehash,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+
+  map.reserve(500);
+  const auto buckets = map.bucketCount();
+  for (K i = 0; i < 500; ++i)
+    map[i] = "x";
+
+  BOOST_CHECK(buckets >= 500);
+  BOOST_CHECK_EQUAL(map.bucketCount(), buckets);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenRehashing_ThenAllItemsAreKept,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 753, "Rome" }, { 1789, "Paris" }, { 1410, "Grunwald" } };
+
+  map.rehash(1);
+
+  BOOST_CHECK(map.bucketCount() >= 3);
+  thenMapContainsItems(map, { { 753, "Rome" }, { 1789, "Paris" }, { 1410, "Grunwald" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenSettingInvalidMaxLoadFactor_ThenExceptionIsThrown,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+
+  BOOST_CHECK_THROW(map.setMaxLoadFactor(0.0f), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapsWithDifferentBucketCounts_WhenComparingThem_ThenTheyAreReportedAsEqual,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(2);
+  Map<K> other(4096);
+  for (K i = 0; i < 100; ++i)
+  {
+    map[i] = "x";
+    other[99 - i] = "x";
+  }
+
+  BOOST_CHECK(map == other);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapWithManyItems_WhenRemovingAndIterating_ThenRemainingItemsAreVisited,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(8);
+  std::map<K, std::string> expected;
+  for (K i = 0; i < 200; ++i)
+    map[i] = "x";
+  for (K i = 0; i < 200; ++i)
+  {
+    if (i % 3 == 0)
+      map.remove(i);
+    else
+      expected[i] = "x";
+  }
+
+  std::size_t visited = 0;
+  for (auto it = map.begin(); it != map.end(); ++it)
+    ++visited;
+
+  BOOST_CHECK_EQUAL(visited, expected.size());
+  thenMapContainsItems(map, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSparseMapWithManyBuckets_WhenIteratingBothWays_ThenAllItemsAreVisited,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(100000);
+  map[5] = "a";
+  map[70000] = "b";
+  map[99999] = "c";
+
+  std::size_t forward = 0;
+  for (auto it = map.begin(); it != map.end(); ++it)
+    ++forward;
+  std::size_t backward = 0;
+  for (auto it = map.end(); it != map.begin(); --it)
+    ++backward;
+
+  BOOST_CHECK_EQUAL(forward, 3u);
+  BOOST_CHECK_EQUAL(backward, 3u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSparseMap_WhenRemovingFirstItem_ThenBeginPointsToNextItem,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(1000);
+  map[5] = "a";
+  map[700] = "b";
+
+  map.remove(5);
+
+  BOOST_CHECK_EQUAL(map.begin()->first, 700);
+  map.remove(700);
+  BOOST_CHECK(map.begin() == map.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenCheckingMoveOperations_ThenTheyAreNoexcept,
+                              K,
+                              TestedKeyTypes)
+{
+  BOOST_CHECK(std::is_nothrow_move_constructible<Map<K>>::value);
+  BOOST_CHECK(std::is_nothrow_move_assignable<Map<K>>::value);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMovedFromMap_WhenAddingItems_ThenItemsAreInMap,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 753, "Rome" } };
+  Map<K> other{std::move(map)};
+
+  BOOST_CHECK(map.find(753) == map.end());
+  BOOST_CHECK(map.begin() == map.end());
+  map[1789] = "Paris";
+
+  thenMapContainsItems(map, { { 1789, "Paris" } });
+  thenMapContainsItems(other, { { 753, "Rome" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoMaps_WhenSwapping_ThenContentsAreExchanged,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 753, "Rome" } };
+  Map<K> other = { { 42, "Alice" }, { 27, "Bob" } };
+
+  swap(map, other);
+
+  thenMapContainsItems(map, { { 42, "Alice" }, { 27, "Bob" } });
+  thenMapContainsItems(other, { { 753, "Rome" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVectorOfMaps_WhenGrowing_ThenMapsAreMovedIntact,
+                              K,
+                              TestedKeyTypes)
+{
+  std::vector<Map<K>> maps;
+  for (K i = 0; i < 20; ++i)
+  {
+    maps.emplace_back();
+    maps.back()[i] = std::to_string(i);
+  }
+
+  for (K i = 0; i < 20; ++i)
+    thenMapContainsItems(maps[i], { { i, std::to_string(i) } });
+}
+
+BOOST_AUTO_TEST_CASE(GivenMapWithCompositeKeyHasher_WhenAddingItems_ThenItemsCanBeFound)
+{
+  aisdi::HashMap<std::pair<int, int>, std::string, PointHash> map;
+
+  for (int x = 0; x < 30; ++x)
+    for (int y = 0; y < 30; ++y)
+      map[std::make_pair(x, y)] = std::to_string(x * y);
+
+  BOOST_CHECK_EQUAL(map.getSize(), 900u);
+  BOOST_CHECK_EQUAL(map.valueOf(std::make_pair(7, 6)), "42");
+  BOOST_CHECK(map.find(std::make_pair(30, 0)) == map.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenMapWithCustomKeyEqual_WhenSearchingForEquivalentKey_ThenItemIsReturned)
+{
+  aisdi::HashMap<std::string, int, CaseInsensitiveHash, CaseInsensitiveEqual> map;
+  map["Rome"] = 753;
+
+  map["ROME"] += 1;
+
+  BOOST_CHECK_EQUAL(map.getSize(), 1u);
+  BOOST_CHECK_EQUAL(map.valueOf("rome"), 754);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenKeysBeingMultiplesOfBucketCount_WhenAddingThem_ThenAllItemsAreInMap,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(1024);
+  std::map<K, std::string> expected;
+
+  for (K i = 0; i < 512; ++i)
+  {
+    map[i * 1024] = "x";
+    expected[i * 1024] = "x";
+  }
+
+  BOOST_CHECK_EQUAL(map.bucketCount() & (map.bucketCount() - 1), 0u);
+  thenMapContainsItems(map, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenRangeOfPairs_WhenConstructingMap_ThenAllItemsAreInMapAndTableIsPresized,
+                              K,
+                              TestedKeyTypes)
+{
+  std::vector<std::pair<K, std::string>> items;
+  for (K i = 0; i < 1000; ++i)
+    items.emplace_back(i, std::to_string(i));
+
+  const Map<K> map(items.begin(), items.end());
+
+  BOOST_CHECK(map.bucketCount() >= 1000);
+  BOOST_CHECK_EQUAL(map.valueOf(999), "999");
+  BOOST_CHECK_EQUAL(map.getSize(), 1000u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenRangeWithDuplicatedKeys_WhenInserting_ThenLastValueWins,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" } };
+  const std::vector<std::pair<K, std::string>> items = { { 27, "Bob" }, { 42, "Chuck" }, { 27, "Dave" } };
+
+  map.insert(items.begin(), items.end());
+
+  thenMapContainsItems(map, { { 42, "Chuck" }, { 27, "Dave" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeRangeOfUniqueKeys_WhenInsertingUnique_ThenAllItemsAreInMap,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 100000, "Alice" } };
+  std::map<K, std::string> expected = { { 100000, "Alice" } };
+  std::vector<std::pair<K, std::string>> items;
+  for (K i = 0; i < 10000; ++i)
+  {
+    items.emplace_back(i * 3, std::to_string(i));
+    expected[i * 3] = std::to_string(i);
+  }
+
+  map.insertUnique(items.begin(), items.end());
+
+  thenMapContainsItems(map, expected);
+  std::size_t visited = 0;
+  for (auto it = map.begin(); it != map.end(); ++it)
+    ++visited;
+  BOOST_CHECK_EQUAL(visited, expected.size());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapWithManyBuckets_WhenAssigningToSmallerMap_ThenAllElementsAreCopied,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(4096);
+  std::map<K, std::string> expected;
+  for (K i = 0; i < 100; ++i)
+  {
+    map[i] = std::to_string(i);
+    expected[i] = std::to_string(i);
+  }
+  Map<K> other;
+
+  other = map;
+
+  BOOST_CHECK_EQUAL(other.bucketCount(), map.bucketCount());
+  thenMapContainsItems(other, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyItems_WhenUsingParallelForEach_ThenEachItemIsVisitedOnce,
+                              K,
+                              TestedKeyTypes)
+{
+  aisdi::ThreadPool pool(3);
+  Map<K> map;
+  for (K i = 0; i < 5000; ++i)
+    map[i] = "x";
+
+  map.parallelForEach([](typename Map<K>::value_type& item) { item.second += std::to_string(item.first); }, pool);
+
+  for (K i = 0; i < 5000; ++i)
+    BOOST_CHECK_EQUAL(map.valueOf(i), "x" + std::to_string(i));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyItems_WhenUsingParallelReduce_ThenResultMatchesSequentialSum,
+                              K,
+                              TestedKeyTypes)
+{
+  aisdi::ThreadPool pool(3);
+  const Map<K> empty;
+  Map<K> map;
+  for (K i = 1; i <= 5000; ++i)
+    map[i] = "x";
+
+  const auto sum = map.parallelReduce(std::uint64_t{0},
+                                      [](const typename Map<K>::value_type& item) { return static_cast<std::uint64_t>(item.first); },
+                                      [](std::uint64_t left, std::uint64_t right) { return left + right; }, pool);
+
+  BOOST_CHECK_EQUAL(sum, 5000u * 5001u / 2);
+  BOOST_CHECK_EQUAL(empty.parallelReduce(std::uint64_t{7}, [](const typename Map<K>::value_type&) { return std::uint64_t{1}; },
+                                         [](std::uint64_t left, std::uint64_t right) { return left + right; }),
+                    7u);
+}
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 
@@ -0,0 +1,457 @@
+#ifndef AISDI_MAPS_PERSISTENTTREEMAP_H
+#define AISDI_MAPS_PERSISTENTTREEMAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace aisdi
+{
+
+// Trwala (niemutowalna) mapa uporzadkowana: drzewo AVL, w ktorym wstawianie i usuwanie
+// kopiuje tylko sciezke od korzenia do zmienianego wezla, a reszte wezlow wspoldzieli
+// z poprzednia wersja. Wezly zwalniane sa przez liczniki referencji shared_ptr.
+// snapshot() kopiuje jeden wskaznik, wiec czytelnicy moga przegladac swoja wersje
+// w innych watkach, podczas gdy jeden pisarz dalej zmienia mape. Czytelnicy pracuja na
+// wlasnym snapshot() - referencje zwracane przez valueOf() zyja tak dlugo jak ich wersja.
+template <typename KeyType, typename ValueType>
+class PersistentTreeMap
+{
+public:
+  using key_type = KeyType;
+  using mapped_type = ValueType;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+
+  class ConstIterator;
+  using const_iterator = ConstIterator;
+  using iterator = ConstIterator;//wartosci sa wspoldzielone miedzy wersjami, wiec nie mozna ich zmieniac w miejscu
+
+private:
+  class Node;
+  using NodePtr = std::shared_ptr<const Node>;
+
+  class Node
+  {
+  public:
+      value_type datapair;
+      NodePtr leftchild;
+      NodePtr rightchild;
+      size_type size;//liczba wezlow w poddrzewie
+      int height;
+
+      Node(const value_type& datapair, NodePtr left, NodePtr right):
+          datapair(datapair), leftchild(std::move(left)), rightchild(std::move(right)),
+          size(1 + sizeOf(leftchild) + sizeOf(rightchild)),
+          height(1 + std::max(heightOf(leftchild), heightOf(rightchild)))
+      {}
+  };
+
+  NodePtr root;//czytany i podmieniany atomowo - patrz loadRoot()
+
+public:
+
+  PersistentTreeMap()
+  {}
+
+  PersistentTreeMap(std::initializer_list<value_type> list)
+  {
+        for(auto it = list.begin(); it != list.end(); it++)
+            insertOrAssign((*it).first, (*it).second);
+  }
+
+  // kopia dzieli wszystkie wezly z oryginalem - O(1)
+  PersistentTreeMap(const PersistentTreeMap& other): root(other.loadRoot())
+  {}
+
+  PersistentTreeMap(PersistentTreeMap&& other) noexcept: root(std::move(other.root))
+  {}
+
+  PersistentTreeMap& operator=(const PersistentTreeMap& other)
+  {
+        if(this != &other)
+            storeRoot(other.loadRoot());
+        return *this;
+  }
+
+  PersistentTreeMap& operator=(PersistentTreeMap&& other) noexcept
+  {
+        if(this != &other)
+            root = std::move(other.root);
+        return *this;
+  }
+
+  // niezmienna wersja mapy z tej chwili; bezpieczne rownolegle z pisarzem
+  PersistentTreeMap snapshot() const
+  {
+        return PersistentTreeMap(*this);
+  }
+
+  bool isEmpty() const
+  {
+        return getSize() == 0;
+  }
+
+  size_type getSize() const
+  {
+        return sizeOf(loadRoot());
+  }
+
+  // wysokosc drzewa AVL - nie wieksza niz 1.44*log2(n+2)
+  size_type height() const
+  {
+        return static_cast<size_type>(heightOf(loadRoot()));
+  }
+
+  bool contains(const key_type& key) const
+  {
+        return findNode(loadRoot().get(), key) != nullptr;
+  }
+
+  const mapped_type& valueOf(const key_type& key) const
+  {
+        const Node* node = findNode(root.get(), key);
+        if(node == nullptr)
+            throw std::out_of_range("valueOf out of range error");
+        return node->datapair.second;
+  }
+
+  const_iterator find(const key_type& key) const
+  {
+        NodePtr current = loadRoot();
+        ConstIterator result(current);
+        for(const Node* temp = current.get(); temp != nullptr;)
+        {
+            result.path.push_back(temp);
+            if(key < temp->datapair.first)
+                temp = temp->leftchild.get();
+            else if(temp->datapair.first < key)
+                temp = temp->rightchild.get();
+            else
+                return result;
+        }
+        return cend();
+  }
+
+  // dodaje pare, jesli klucza nie ma; istniejaca wartosc zostaje bez zmian
+  bool insert(const key_type& key, const mapped_type& mapped)
+  {
+        if(findNode(root.get(), key) != nullptr)
+            return false;
+        bool added = false;
+        storeRoot(insertNode(root, key, mapped, added));
+        return true;
+  }
+
+  // zwraca true, gdy klucz zostal dodany, false, gdy nadpisano wartosc
+  bool insertOrAssign(const key_type& key, const mapped_type& mapped)
+  {
+        bool added = false;
+        storeRoot(insertNode(root, key, mapped, added));
+        return added;
+  }
+
+  void remove(const key_type& key)
+  {
+        if(findNode(root.get(), key) == nullptr)
+            throw std::out_of_range("remove out of range");
+        storeRoot(removeNode(root, key));
+  }
+
+  void remove(const const_iterator& it)
+  {
+        if(it.path.empty())
+            throw std::out_of_range("remove out of range");
+        const key_type key = (*it).first;
+        remove(key);
+  }
+
+  void clear()
+  {
+        storeRoot(NodePtr());
+  }
+
+  bool operator==(const PersistentTreeMap& other) const
+  {
+        const PersistentTreeMap left = snapshot();
+        const PersistentTreeMap right = other.snapshot();
+        if(left.root == right.root)
+            return true;
+        if(left.getSize() != right.getSize())
+            return false;
+
+        for(auto it = left.begin(), otherIt = right.begin(); it != left.end(); ++it, ++otherIt)
+            if(it->first < otherIt->first || otherIt->first < it->first || !(it->second == otherIt->second))
+                return false;
+        return true;
+  }
+
+  bool operator!=(const PersistentTreeMap& other) const
+  {
+        return !(*this == other);
+  }
+
+  // iterator trzyma korzen swojej wersji, wiec pozostaje wazny po zmianach mapy
+  const_iterator cbegin() const
+  {
+        ConstIterator result(loadRoot());
+        result.pushLeftSpine(result.version.get());
+        return result;
+  }
+
+  const_iterator cend() const
+  {
+        return ConstIterator(loadRoot());
+  }
+
+  const_iterator begin() const
+  {
+        return cbegin();
+  }
+
+  const_iterator end() const
+  {
+        return cend();
+  }
+
+private:
+
+  // std::atomic_load/atomic_store dla shared_ptr: czytelnik nigdy nie widzi
+  // polowicznie podmienionego wskaznika, a licznik referencji chroni wersje przed zwolnieniem
+  NodePtr loadRoot() const
+  {
+        return std::atomic_load(&root);
+  }
+
+  void storeRoot(NodePtr newRoot)
+  {
+        std::atomic_store(&root, std::move(newRoot));
+  }
+
+  static size_type sizeOf(const NodePtr& node)
+  {
+        return node ? node->size : 0;
+  }
+
+  static int heightOf(const NodePtr& node)
+  {
+        return node ? node->height : 0;
+  }
+
+  static NodePtr makeNode(const value_type& datapair, NodePtr left, NodePtr right)
+  {
+        return std::make_shared<Node>(datapair, std::move(left), std::move(right));
+  }
+
+  static const Node* findNode(const Node* temp, const key_type& key)
+  {
+        while(temp != nullptr)
+        {
+            if(key < temp->datapair.first)
+                temp = temp->leftchild.get();
+            else if(temp->datapair.first < key)
+                temp = temp->rightchild.get();
+            else
+                return temp;
+        }
+        return nullptr;
+  }
+
+  // tworzy nowy wezel z danymi datapair nad left i right, obracajac go, gdy roznica wysokosci przekracza 1
+  static NodePtr balance(const value_type& datapair, NodePtr left, NodePtr right)
+  {
+        const int leftHeight = heightOf(left);
+        const int rightHeight = heightOf(right);
+
+        if(leftHeight > rightHeight + 1)
+        {
+            if(heightOf(left->leftchild) >= heightOf(left->rightchild))
+                return makeNode(left->datapair, left->leftchild, makeNode(datapair, left->rightchild, std::move(right)));
+            const Node* middle = left->rightchild.get();
+            return makeNode(middle->datapair, makeNode(left->datapair, left->leftchild, middle->leftchild),
+                            makeNode(datapair, middle->rightchild, std::move(right)));
+        }
+        if(rightHeight > leftHeight + 1)
+        {
+            if(heightOf(right->rightchild) >= heightOf(right->leftchild))
+                return makeNode(right->datapair, makeNode(datapair, std::move(left), right->leftchild), right->rightchild);
+            const Node* middle = right->leftchild.get();
+            return makeNode(middle->datapair, makeNode(datapair, std::move(left), middle->leftchild),
+                            makeNode(right->datapair, middle->rightchild, right->rightchild));
+        }
+        return makeNode(datapair, std::move(left), std::move(right));
+  }
+
+  static NodePtr insertNode(const NodePtr& node, const key_type& key, const mapped_type& mapped, bool& added)
+  {
+        if(!node)
+        {
+            added = true;
+            return makeNode(value_type(key, mapped), nullptr, nullptr);
+        }
+        if(key < node->datapair.first)
+            return balance(node->datapair, insertNode(node->leftchild, key, mapped, added), node->rightchild);
+        if(node->datapair.first < key)
+            return balance(node->datapair, node->leftchild, insertNode(node->rightchild, key, mapped, added));
+        return makeNode(value_type(key, mapped), node->leftchild, node->rightchild);
+  }
+
+  static NodePtr removeMin(const NodePtr& node)
+  {
+        if(!node->leftchild)
+            return node->rightchild;
+        return balance(node->datapair, removeMin(node->leftchild), node->rightchild);
+  }
+
+  // klucz musi byc w drzewie
+  static NodePtr removeNode(const NodePtr& node, const key_type& key)
+  {
+        if(key < node->datapair.first)
+            return balance(node->datapair, removeNode(node->leftchild, key), node->rightchild);
+        if(node->datapair.first < key)
+            return balance(node->datapair, node->leftchild, removeNode(node->rightchild, key));
+
+        if(!node->leftchild)
+            return node->rightchild;
+        if(!node->rightchild)
+            return node->leftchild;
+
+        const Node* successor = node->rightchild.get();
+        while(successor->leftchild)
+            successor = successor->leftchild.get();
+        return balance(successor->datapair, node->leftchild, removeMin(node->rightchild));
+  }
+};
+
+template <typename KeyType, typename ValueType>
+class PersistentTreeMap<KeyType, ValueType>::ConstIterator
+{
+public:
+  using reference = typename PersistentTreeMap::const_reference;
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename PersistentTreeMap::value_type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const typename PersistentTreeMap::value_type*;
+
+private:
+  NodePtr version;//korzen wersji, po ktorej chodzi iterator
+  std::vector<const Node*> path;//sciezka od korzenia do biezacego wezla; pusta dla end()
+  friend class PersistentTreeMap;
+
+  explicit ConstIterator(NodePtr version): version(std::move(version))
+  {}
+
+  void pushLeftSpine(const Node* node)
+  {
+    for(; node != nullptr; node = node->leftchild.get())
+        path.push_back(node);
+  }
+
+  void pushRightSpine(const Node* node)
+  {
+    for(; node != nullptr; node = node->rightchild.get())
+        path.push_back(node);
+  }
+
+public:
+
+  ConstIterator()
+  {}
+
+  ConstIterator& operator++()
+  {
+    if(path.empty())
+        throw std::out_of_range("operator++ out of range");
+
+    const Node* current = path.back();
+    if(current->rightchild)
+    {
+        pushLeftSpine(current->rightchild.get());
+        return *this;
+    }
+    // w gore, az wyjdziemy z lewego poddrzewa
+    path.pop_back();
+    while(!path.empty() && path.back()->rightchild.get() == current)
+    {
+        current = path.back();
+        path.pop_back();
+    }
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    auto result = *this;
+    operator++();
+    return result;
+  }
+
+  ConstIterator& operator--()
+  {
+    if(path.empty())
+    {
+        if(!version)
+            throw std::out_of_range("operator-- out of range");
+        pushRightSpine(version.get());
+        return *this;
+    }
+
+    if(path.back()->leftchild)
+    {
+        pushRightSpine(path.back()->leftchild.get());
+        return *this;
+    }
+
+    // poprzednik to pierwszy przodek, do ktorego wchodzimy z prawego poddrzewa
+    size_type index = path.size() - 1;
+    while(index > 0 && path[index - 1]->leftchild.get() == path[index])
+        index--;
+    if(index == 0)
+        throw std::out_of_range("operator-- out of range");
+    path.resize(index);
+    return *this;
+  }
+
+  ConstIterator operator--(int)
+  {
+    auto result = *this;
+    operator--();
+    return result;
+  }
+
+  reference operator*() const
+  {
+    if(path.empty())
+        throw std::out_of_range("operator* out of range");
+    return path.back()->datapair;
+  }
+
+  pointer operator->() const
+  {
+    return &this->operator*();
+  }
+
+  bool operator==(const ConstIterator& other) const
+  {
+    const Node* current = path.empty() ? nullptr : path.back();
+    const Node* otherCurrent = other.path.empty() ? nullptr : other.path.back();
+    // wezly sa wspoldzielone miedzy wersjami, wiec wystarczy porownac biezacy wezel
+    return current == otherCurrent;
+  }
+
+  bool operator!=(const ConstIterator& other) const
+  {
+    return !(*this == other);
+  }
+};
+
+}
+
+#endif /* AISDI_MAPS_PERSISTENTTREEMAP_H */
@@ -0,0 +1,225 @@
+#include <PersistentTreeMap.h>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedKeyTypes = boost::mpl::list<std::int32_t, std::uint64_t>;
+
+template <typename K>
+using Map = aisdi::PersistentTreeMap<K, std::string>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(PersistentTreeMapsTests)
+
+template <typename K>
+void thenMapContainsItems(const Map<K>& map,
+                          const std::map<K, std::string>& expected)
+{
+  BOOST_CHECK_EQUAL(map.getSize(), expected.size());
+
+  auto it = begin(map);
+  for (const auto& item : expected)
+  {
+    BOOST_REQUIRE_MESSAGE(it != end(map), "Missing required item with key: " << item.first);
+    BOOST_CHECK_EQUAL(it->first, item.first);
+    BOOST_CHECK_EQUAL(it->second, item.second);
+    ++it;
+  }
+  BOOST_CHECK(it == end(map));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map;
+
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(begin(map) == end(map));
+  BOOST_CHECK_THROW(--end(map), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInitializingFromListOfPairs_ThenItemsAreInOrder,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map = { { 42, "Alice" }, { 27, "Bob" }, { 99, "Chuck" } };
+
+  thenMapContainsItems(map, { { 27, "Bob" }, { 42, "Alice" }, { 99, "Chuck" } });
+  BOOST_CHECK_EQUAL(map.valueOf(42), "Alice");
+  BOOST_CHECK_THROW(map.valueOf(43), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenInsertingExistingKey_ThenOnlyInsertOrAssignChangesValue,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" } };
+
+  BOOST_CHECK(!map.insert(42, "Bob"));
+  BOOST_CHECK_EQUAL(map.valueOf(42), "Alice");
+  BOOST_CHECK(!map.insertOrAssign(42, "Bob"));
+  BOOST_CHECK_EQUAL(map.valueOf(42), "Bob");
+  BOOST_CHECK(map.insert(43, "Chuck"));
+  BOOST_CHECK_EQUAL(map.getSize(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSnapshot_WhenChangingMap_ThenSnapshotKeepsOldVersion,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  const Map<K> snapshot = map.snapshot();
+  map.insertOrAssign(42, "Chuck");
+  map.remove(27);
+  map.insert(13, "Dave");
+
+  thenMapContainsItems(snapshot, { { 27, "Bob" }, { 42, "Alice" } });
+  thenMapContainsItems(map, { { 13, "Dave" }, { 42, "Chuck" } });
+  BOOST_CHECK(snapshot != map);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenChangingMap_ThenIteratorWalksItsOwnVersion,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 1, "a" }, { 2, "b" }, { 3, "c" } };
+
+  auto it = map.begin();
+  map.clear();
+
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK_EQUAL(it->second, "a");
+  ++it;
+  BOOST_CHECK_EQUAL((it++)->second, "b");
+  BOOST_CHECK_EQUAL(it->second, "c");
+  BOOST_CHECK(++it == end(map));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenRemovingMissingKey_ThenExceptionIsThrown,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" } };
+
+  BOOST_CHECK_THROW(map.remove(27), std::out_of_range);
+  BOOST_CHECK_THROW(map.remove(end(map)), std::out_of_range);
+  map.remove(map.find(42));
+  BOOST_CHECK(map.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenMovingBothWays_ThenItemsAreVisitedInOrder,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (K i = 0; i < 100; ++i)
+    map.insert(i * 2, "x");
+
+  auto it = map.find(50);
+  BOOST_CHECK_EQUAL((++it)->first, K{52});
+  BOOST_CHECK_EQUAL((--it)->first, K{50});
+  BOOST_CHECK_EQUAL((--it)->first, K{48});
+  BOOST_CHECK(map.find(51) == end(map));
+
+  K expected = 200;
+  for (auto back = end(map); back != begin(map);)
+  {
+    --back;
+    expected -= 2;
+    BOOST_CHECK_EQUAL(back->first, expected);
+  }
+  BOOST_CHECK_THROW(--begin(map), std::out_of_range);
+  BOOST_CHECK_THROW(++end(map), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenMixingInsertsAndRemovals_ThenItMatchesStdMapAndStaysBalanced,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  std::vector<Map<K>> versions;
+  std::uint32_t seed = 99;
+
+  for (int i = 0; i < 20000; ++i)
+  {
+    seed = seed * 1103515245u + 12345u;
+    const K key = static_cast<K>((seed >> 8) % 2000);
+    if ((seed >> 4) % 3 == 0 && map.contains(key))
+    {
+      map.remove(key);
+      expected.erase(key);
+    }
+    else
+    {
+      map.insertOrAssign(key, std::to_string(i));
+      expected[key] = std::to_string(i);
+    }
+    if (i % 5000 == 0)
+      versions.push_back(map.snapshot());
+  }
+
+  thenMapContainsItems(map, expected);
+  BOOST_CHECK_LE(map.height(), 16u);
+  for (const auto& version : versions)
+    BOOST_CHECK_LE(version.height(), 16u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenWriterThread_WhenReadersTakeSnapshots_ThenEachSnapshotIsConsistent)
+{
+  aisdi::PersistentTreeMap<int, int> map;
+  std::atomic<bool> done(false);
+  std::atomic<int> inconsistent(0);
+
+  // pisarz dopisuje klucze na koncu i usuwa z poczatku, wiec kazda wersja to ciagly przedzial
+  std::thread writer([&map, &done]() {
+    for (int i = 0; i < 20000; ++i)
+    {
+      map.insert(i, 2 * i);
+      if (i >= 1000)
+        map.remove(i - 1000);
+    }
+    done = true;
+  });
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 2; ++t)
+    readers.emplace_back([&map, &done, &inconsistent]() {
+      while (!done)
+      {
+        const auto snapshot = map.snapshot();
+        std::size_t count = 0;
+        int previous = 0;
+        for (const auto& item : snapshot)
+        {
+          if ((count > 0 && item.first != previous + 1) || item.second != 2 * item.first)
+            ++inconsistent;
+          previous = item.first;
+          ++count;
+        }
+        if (count != snapshot.getSize())
+          ++inconsistent;
+      }
+    });
+
+  writer.join();
+  for (auto& reader : readers)
+    reader.join();
+
+  BOOST_CHECK_EQUAL(inconsistent.load(), 0);
+  BOOST_CHECK_EQUAL(map.getSize(), 1000u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
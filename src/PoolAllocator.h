@@ -0,0 +1,188 @@
+#ifndef AISDI_MAPS_POOLALLOCATOR_H
+#define AISDI_MAPS_POOLALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+// Bloki stalego rozmiaru wycinane z duzych kawalkow pamieci; zwolnione bloki trafiaja
+// na liste wolnych i sa uzywane ponownie. Kawalki oddawane sa dopiero w destruktorze.
+// Nie jest bezpieczna watkowo - tak jak kontenery, ktore z niej korzystaja.
+class NodePool
+{
+public:
+  static const std::size_t FIRST_CHUNK_BLOCKS = 32;
+  static const std::size_t MAX_CHUNK_BLOCKS = 65536;
+
+  explicit NodePool(std::size_t blockSize):
+      block_size(roundUp(blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize)),
+      chunk_blocks(FIRST_CHUNK_BLOCKS), free_list(nullptr), cursor(nullptr), chunk_end(nullptr)
+  {}
+
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+
+  ~NodePool()
+  {
+      for(void* chunk : chunks)
+          ::operator delete(chunk);
+  }
+
+  void* allocate()
+  {
+      if(free_list != nullptr)
+      {
+          FreeBlock* block = free_list;
+          free_list = block->next;
+          return block;
+      }
+      if(cursor == chunk_end)
+          addChunk();
+      void* block = cursor;
+      cursor += block_size;
+      return block;
+  }
+
+  void deallocate(void* pointer) noexcept
+  {
+      FreeBlock* block = static_cast<FreeBlock*>(pointer);
+      block->next = free_list;
+      free_list = block;
+  }
+
+  std::size_t chunkCount() const
+  {
+      return chunks.size();
+  }
+
+private:
+  struct FreeBlock
+  {
+      FreeBlock* next;
+  };
+
+  static std::size_t roundUp(std::size_t size)
+  {
+      const std::size_t alignment = alignof(std::max_align_t);
+      return (size + alignment - 1) / alignment * alignment;
+  }
+
+  void addChunk()
+  {
+      chunks.reserve(chunks.size() + 1);
+      char* chunk = static_cast<char*>(::operator new(block_size * chunk_blocks));
+      chunks.push_back(chunk);
+      cursor = chunk;
+      chunk_end = chunk + block_size * chunk_blocks;
+      if(chunk_blocks < MAX_CHUNK_BLOCKS)
+          chunk_blocks *= 2;
+  }
+
+  std::size_t block_size;
+  std::size_t chunk_blocks;
+  FreeBlock* free_list;
+  char* cursor;
+  char* chunk_end;
+  std::vector<void*> chunks;
+};
+
+}
+
+// Alokator wezlow dla map: pojedyncze obiekty pochodza z puli, wieksze tablice z operator new.
+// Kopie alokatora dziela pule; pula powstaje przy pierwszej alokacji.
+template <typename T>
+class PoolAllocator
+{
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  template <typename U>
+  struct rebind
+  {
+      using other = PoolAllocator<U>;
+  };
+
+  PoolAllocator() noexcept
+  {}
+
+  PoolAllocator(const PoolAllocator& other) noexcept: pool(other.pool)
+  {}
+
+  PoolAllocator(PoolAllocator&& other) noexcept: pool(std::move(other.pool))
+  {}
+
+  // pula jest zwiazana z rozmiarem bloku, wiec alokator innego typu zaczyna z wlasna
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>&) noexcept
+  {}
+
+  PoolAllocator& operator=(const PoolAllocator& other) noexcept
+  {
+      pool = other.pool;
+      return *this;
+  }
+
+  PoolAllocator& operator=(PoolAllocator&& other) noexcept
+  {
+      pool = std::move(other.pool);
+      return *this;
+  }
+
+  T* allocate(size_type count)
+  {
+      static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+      if(count != 1)
+          return static_cast<T*>(::operator new(count * sizeof(T)));
+      if(!pool)
+          pool = std::make_shared<detail::NodePool>(sizeof(T));
+      return static_cast<T*>(pool->allocate());
+  }
+
+  void deallocate(T* pointer, size_type count) noexcept
+  {
+      if(count != 1)
+          ::operator delete(pointer);
+      else
+          pool->deallocate(pointer);
+  }
+
+  PoolAllocator select_on_container_copy_construction() const
+  {
+      return PoolAllocator();
+  }
+
+  std::size_t chunkCount() const
+  {
+      return pool ? pool->chunkCount() : 0;
+  }
+
+  bool operator==(const PoolAllocator& other) const
+  {
+      return pool == other.pool;
+  }
+
+  bool operator!=(const PoolAllocator& other) const
+  {
+      return !(*this == other);
+  }
+
+private:
+  std::shared_ptr<detail::NodePool> pool;
+};
+
+}
+
+#endif /* AISDI_MAPS_POOLALLOCATOR_H */
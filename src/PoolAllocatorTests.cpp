@@ -0,0 +1,79 @@
+#include <PoolAllocator.h>
+#include <HashMap.h>
+#include <TreeMap.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(PoolAllocatorTests)
+
+BOOST_AUTO_TEST_CASE(GivenAllocator_WhenDeallocatingAndAllocating_ThenBlockIsReused)
+{
+  aisdi::PoolAllocator<std::uint64_t> allocator;
+
+  std::uint64_t* first = allocator.allocate(1);
+  allocator.deallocate(first, 1);
+  std::uint64_t* second = allocator.allocate(1);
+
+  BOOST_CHECK(first == second);
+  allocator.deallocate(second, 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenAllocator_WhenAllocatingManyBlocks_ThenTheyComeFromFewChunks)
+{
+  aisdi::PoolAllocator<std::uint64_t> allocator;
+
+  for (int i = 0; i < 1000; ++i)
+    allocator.allocate(1);
+
+  BOOST_CHECK(allocator.chunkCount() > 0);
+  BOOST_CHECK(allocator.chunkCount() < 10);
+}
+
+BOOST_AUTO_TEST_CASE(GivenAllocatorCopy_WhenComparing_ThenCopiesShareThePool)
+{
+  aisdi::PoolAllocator<std::uint64_t> allocator;
+  allocator.deallocate(allocator.allocate(1), 1);
+
+  aisdi::PoolAllocator<std::uint64_t> copy(allocator);
+
+  BOOST_CHECK(copy == allocator);
+  BOOST_CHECK(copy.select_on_container_copy_construction() != allocator);
+}
+
+BOOST_AUTO_TEST_CASE(GivenAllocatorForArrays_WhenAllocatingSeveralObjects_ThenPoolIsNotUsed)
+{
+  aisdi::PoolAllocator<std::uint64_t> allocator;
+
+  std::uint64_t* array = allocator.allocate(4);
+  array[3] = 42;
+  allocator.deallocate(array, 4);
+
+  BOOST_CHECK_EQUAL(allocator.chunkCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMapsWithStandardAllocator_WhenAddingItems_ThenTheyWork)
+{
+  using Value = std::pair<const int, std::string>;
+  aisdi::HashMap<int, std::string, std::hash<int>, std::equal_to<int>, std::allocator<Value>> hashMap;
+  aisdi::TreeMap<int, std::string, std::allocator<Value>> treeMap;
+
+  for (int i = 0; i < 100; ++i)
+  {
+    hashMap[i] = "x";
+    treeMap[i] = "x";
+  }
+  hashMap.remove(42);
+
+  BOOST_CHECK_EQUAL(hashMap.getSize(), 99u);
+  BOOST_CHECK_EQUAL(treeMap.getSize(), 100u);
+  BOOST_CHECK(hashMap.find(42) == hashMap.end());
+  BOOST_CHECK(treeMap.find(42) != treeMap.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
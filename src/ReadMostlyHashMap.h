@@ -0,0 +1,335 @@
+#ifndef AISDI_MAPS_READMOSTLYHASHMAP_H
+#define AISDI_MAPS_READMOSTLYHASHMAP_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "EpochReclamation.h"
+
+namespace aisdi
+{
+
+// Mapa z lancuchowaniem dla danych czytanych bardzo czesto i zmienianych rzadko (konfiguracja,
+// tablice routingu). Czytelnicy nie biora blokad i nie pisza do wspolnej pamieci: przechodza
+// po wskaznikach publikowanych jak w RCU, a przypiecie do epoki zapisuje tylko rekord watku.
+// Wezly sa niezmienne - zmiana wartosci wstawia kopie wezla w miejsce starego, a przebudowa
+// tablicy buduje nowa tablice z kopiami wezlow i podmienia ja jednym zapisem. Stare wezly
+// i tablice zwalnia EpochReclamation. Piszacy sa szeregowani jedna blokada.
+template <typename KeyType, typename ValueType,
+          typename Hash = std::hash<KeyType>,
+          typename KeyEqual = std::equal_to<KeyType>>
+class ReadMostlyHashMap
+{
+public:
+  using key_type = KeyType;
+  using mapped_type = ValueType;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+private:
+    class HashNode
+    {
+         public:
+        std::atomic<HashNode*> next;
+        const size_type hash;//pelny skrot klucza, liczony tylko raz
+        const value_type datapair;
+
+        HashNode(const key_type& key, const mapped_type& mapped, size_type hash, HashNode* next):
+            next(next), hash(hash), datapair(key, mapped){}
+    };
+
+    // kubelki leza tuz za naglowkiem; tablica po opublikowaniu nie zmienia rozmiaru
+    class Table
+    {
+         public:
+        const size_type size;
+
+        std::atomic<HashNode*>* buckets()
+        {
+            return reinterpret_cast<std::atomic<HashNode*>*>(this + 1);
+        }
+
+        static Table* create(size_type size)
+        {
+            void* memory = ::operator new(sizeof(Table) + size * sizeof(std::atomic<HashNode*>));
+            Table* table = new (memory) Table(size);
+            for(size_type i = 0; i < size; i++)
+                new (table->buckets() + i) std::atomic<HashNode*>(nullptr);
+            return table;
+        }
+
+        // zwalnia tez wezly, ktore sa jeszcze w kubelkach
+        static void destroy(void* pointer)
+        {
+            Table* table = static_cast<Table*>(pointer);
+            for(size_type i = 0; i < table->size; i++)
+            {
+                HashNode* temp = table->buckets()[i].load(std::memory_order_relaxed);
+                while(temp != nullptr)
+                {
+                    HashNode* next = temp->next.load(std::memory_order_relaxed);
+                    delete temp;
+                    temp = next;
+                }
+            }
+            table->~Table();
+            ::operator delete(table);
+        }
+
+         private:
+        explicit Table(size_type size): size(size){}
+    };
+
+    static const size_type DEFAULT_TABLE_SIZE = 16;
+
+    // pola czytane przez czytelnikow
+    hasher hash_function;
+    key_equal key_eq;
+    std::atomic<Table*> table;
+    char padding[64];//pola piszacego w osobnej linii pamieci podrecznej
+
+    // pola piszacego
+    std::mutex writer_lock;
+    std::atomic<size_type> counter;
+    float max_load_factor;
+
+public:
+
+  ReadMostlyHashMap(): ReadMostlyHashMap(DEFAULT_TABLE_SIZE)
+  {}
+
+  explicit ReadMostlyHashMap(size_type bucketCount, const hasher& hash = hasher(),
+                             const key_equal& equal = key_equal()):
+      hash_function(hash), key_eq(equal), table(Table::create(roundToPowerOfTwo(bucketCount))),
+      counter(0), max_load_factor(1.0f)
+  {}
+
+  ReadMostlyHashMap(std::initializer_list<value_type> list): ReadMostlyHashMap(list.size())
+  {
+        for(auto it = list.begin(); it != list.end(); it++)
+            insertOrAssign((*it).first, (*it).second);
+  }
+
+  ReadMostlyHashMap(const ReadMostlyHashMap&) = delete;
+  ReadMostlyHashMap& operator=(const ReadMostlyHashMap&) = delete;
+
+  // zaklada, ze zaden watek nie korzysta juz z mapy
+  ~ReadMostlyHashMap()
+  {
+        Table::destroy(table.load(std::memory_order_relaxed));
+  }
+
+  bool isEmpty() const
+  {
+        return getSize() == 0;
+  }
+
+  size_type getSize() const
+  {
+        return counter.load(std::memory_order_relaxed);
+  }
+
+  size_type bucketCount() const
+  {
+        EpochReclamation::Guard guard;
+        return table.load(std::memory_order_acquire)->size;
+  }
+
+  bool contains(const key_type& key) const
+  {
+        EpochReclamation::Guard guard;
+        return findNode(key, hash_function(key)) != nullptr;
+  }
+
+  // kopiuje wartosc do result; false, gdy klucza nie ma
+  bool find(const key_type& key, mapped_type& result) const
+  {
+        EpochReclamation::Guard guard;
+        const HashNode* node = findNode(key, hash_function(key));
+        if(node == nullptr)
+            return false;
+        result = node->datapair.second;
+        return true;
+  }
+
+  mapped_type valueOf(const key_type& key) const
+  {
+        mapped_type result;
+        if(!find(key, result))
+            throw std::out_of_range("valueOf out of range error");
+        return result;
+  }
+
+  // dodaje pare, jesli klucza nie ma; istniejaca wartosc zostaje bez zmian
+  bool insert(const key_type& key, const mapped_type& mapped)
+  {
+        return put(key, mapped, false);
+  }
+
+  // zwraca true, gdy klucz zostal dodany, false, gdy podmieniono wartosc
+  bool insertOrAssign(const key_type& key, const mapped_type& mapped)
+  {
+        return put(key, mapped, true);
+  }
+
+  bool remove(const key_type& key)
+  {
+        const size_type hash = hash_function(key);
+        std::lock_guard<std::mutex> writer(writer_lock);
+
+        std::atomic<HashNode*>* link = findLink(key, hash);
+        HashNode* node = link->load(std::memory_order_relaxed);
+        if(node == nullptr)
+            return false;
+
+        // czytelnik stojacy na node nadal widzi jego nastepnika, wiec nikt nie gubi reszty lancucha
+        link->store(node->next.load(std::memory_order_relaxed), std::memory_order_release);
+        counter.fetch_sub(1, std::memory_order_relaxed);
+        EpochReclamation::instance().retire(node);
+        return true;
+  }
+
+  void clear()
+  {
+        std::lock_guard<std::mutex> writer(writer_lock);
+        Table* old = table.load(std::memory_order_relaxed);
+        table.store(Table::create(old->size), std::memory_order_release);
+        counter.store(0, std::memory_order_relaxed);
+        EpochReclamation::instance().retire(old, &Table::destroy);
+  }
+
+  float maxLoadFactor() const
+  {
+        return max_load_factor;
+  }
+
+  void setMaxLoadFactor(float factor)
+  {
+        if(!(factor > 0.0f))
+            throw std::invalid_argument("max load factor must be positive");
+        std::lock_guard<std::mutex> writer(writer_lock);
+        max_load_factor = factor;
+        growIfNeeded(0);
+  }
+
+private:
+
+  static size_type roundToPowerOfTwo(size_type count)
+  {
+      size_type result = 2;
+      while(result < count)
+          result *= 2;
+      return result;
+  }
+
+  static size_type mix(size_type hash)
+  {
+      std::uint64_t mixed = static_cast<std::uint64_t>(hash) * 11400714819323198485ull;
+      return static_cast<size_type>(mixed ^ (mixed >> 32));
+  }
+
+  static std::atomic<HashNode*>& bucketOf(Table* table, size_type hash)
+  {
+      return table->buckets()[mix(hash) & (table->size - 1)];
+  }
+
+  // wywolywane przez przypietego czytelnika
+  const HashNode* findNode(const key_type& key, size_type hash) const
+  {
+      Table* current = table.load(std::memory_order_acquire);
+      for(const HashNode* temp = bucketOf(current, hash).load(std::memory_order_acquire); temp != nullptr;
+          temp = temp->next.load(std::memory_order_acquire))
+          if(temp->hash == hash && key_eq(temp->datapair.first, key))
+              return temp;
+      return nullptr;
+  }
+
+  // wywolywane pod blokada piszacego; wskaznik prowadzacy do wezla z kluczem
+  // albo koncowy nullptr lancucha
+  std::atomic<HashNode*>* findLink(const key_type& key, size_type hash)
+  {
+      std::atomic<HashNode*>* link = &bucketOf(table.load(std::memory_order_relaxed), hash);
+      while(true)
+      {
+          HashNode* node = link->load(std::memory_order_relaxed);
+          if(node == nullptr || (node->hash == hash && key_eq(node->datapair.first, key)))
+              return link;
+          link = &node->next;
+      }
+  }
+
+  bool put(const key_type& key, const mapped_type& mapped, bool assign)
+  {
+      const size_type hash = hash_function(key);
+      std::lock_guard<std::mutex> writer(writer_lock);
+
+      std::atomic<HashNode*>* link = findLink(key, hash);
+      HashNode* node = link->load(std::memory_order_relaxed);
+      if(node != nullptr)
+      {
+          if(!assign)
+              return false;
+          // kopia wezla z nowa wartoscia; release publikuje ja razem z zawartoscia
+          link->store(new HashNode(key, mapped, hash, node->next.load(std::memory_order_relaxed)),
+                      std::memory_order_release);
+          EpochReclamation::instance().retire(node);
+          return false;
+      }
+
+      growIfNeeded(1);
+      std::atomic<HashNode*>& bucket = bucketOf(table.load(std::memory_order_relaxed), hash);
+      bucket.store(new HashNode(key, mapped, hash, bucket.load(std::memory_order_relaxed)),
+                   std::memory_order_release);
+      counter.fetch_add(1, std::memory_order_relaxed);
+      return true;
+  }
+
+  // wywolywane pod blokada piszacego. Przepiecie istniejacych wezli zgubiloby czytelnikom
+  // czesc lancucha, wiec nowa tablica dostaje kopie, a stara odchodzi w calosci.
+  void growIfNeeded(size_type added)
+  {
+      Table* old = table.load(std::memory_order_relaxed);
+      const size_type needed = counter.load(std::memory_order_relaxed) + added;
+      if(needed <= old->size * max_load_factor)
+          return;
+
+      size_type size = old->size * 2;
+      while(needed > size * max_load_factor)
+          size *= 2;
+
+      Table* grown = Table::create(size);
+      try
+      {
+          for(size_type i = 0; i < old->size; i++)
+              for(HashNode* temp = old->buckets()[i].load(std::memory_order_relaxed); temp != nullptr;
+                  temp = temp->next.load(std::memory_order_relaxed))
+              {
+                  std::atomic<HashNode*>& bucket = bucketOf(grown, temp->hash);
+                  bucket.store(new HashNode(temp->datapair.first, temp->datapair.second, temp->hash,
+                                            bucket.load(std::memory_order_relaxed)),
+                               std::memory_order_relaxed);
+              }
+      }
+      catch(...)
+      {
+          Table::destroy(grown);
+          throw;
+      }
+
+      table.store(grown, std::memory_order_release);
+      EpochReclamation::instance().retire(old, &Table::destroy);
+  }
+};
+
+}
+
+#endif /* AISDI_MAPS_READMOSTLYHASHMAP_H */
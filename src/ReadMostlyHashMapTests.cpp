@@ -0,0 +1,144 @@
+#include <ReadMostlyHashMap.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedKeyTypes = boost::mpl::list<std::int32_t, std::uint64_t>;
+
+template <typename K>
+using Map = aisdi::ReadMostlyHashMap<K, std::string>;
+
+BOOST_AUTO_TEST_SUITE(ReadMostlyHashMapsTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map;
+
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(!map.contains(0));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInitializingFromListOfPairs_ThenAllItemsAreInMap,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map = { { 753, "Rome" }, { 1789, "Paris" } };
+  std::string value;
+
+  BOOST_CHECK_EQUAL(map.getSize(), 2u);
+  BOOST_CHECK_EQUAL(map.valueOf(753), "Rome");
+  BOOST_CHECK(map.find(1789, value));
+  BOOST_CHECK_EQUAL(value, "Paris");
+  BOOST_CHECK(!map.find(1410, value));
+  BOOST_CHECK_THROW(map.valueOf(1410), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenInsertingExistingKey_ThenOnlyInsertOrAssignChangesValue,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" } };
+
+  BOOST_CHECK(!map.insert(42, "Bob"));
+  BOOST_CHECK_EQUAL(map.valueOf(42), "Alice");
+  BOOST_CHECK(!map.insertOrAssign(42, "Bob"));
+  BOOST_CHECK_EQUAL(map.valueOf(42), "Bob");
+  BOOST_CHECK(map.insertOrAssign(43, "Chuck"));
+  BOOST_CHECK_EQUAL(map.getSize(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenKeysInOneChain_WhenRemovingMiddleOne_ThenOthersStay,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(2);
+  map.setMaxLoadFactor(100.0f);
+  for (K i = 0; i < 50; ++i)
+    map.insert(i, std::to_string(i));
+
+  BOOST_CHECK(map.remove(25));
+  BOOST_CHECK(!map.remove(25));
+  BOOST_CHECK_EQUAL(map.getSize(), 49u);
+  BOOST_CHECK_EQUAL(map.bucketCount(), 2u);
+  for (K i = 0; i < 50; ++i)
+    BOOST_CHECK_EQUAL(map.contains(i), i != 25);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyInserts_WhenTableGrows_ThenAllItemsStayReachable,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (K i = 0; i < 5000; ++i)
+    map.insert(i, std::to_string(i));
+
+  BOOST_CHECK_EQUAL(map.getSize(), 5000u);
+  BOOST_CHECK_GE(map.bucketCount() * map.maxLoadFactor(), 5000.0f);
+  for (K i = 0; i < 5000; ++i)
+    BOOST_CHECK_EQUAL(map.valueOf(i), std::to_string(i));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenClearing_ThenItIsEmptyAndUsable,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 1, "a" }, { 2, "b" } };
+
+  map.clear();
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(!map.contains(1));
+  map.insert(1, "c");
+  BOOST_CHECK_EQUAL(map.valueOf(1), "c");
+}
+
+BOOST_AUTO_TEST_CASE(GivenReadersAndWriter_WhenRunningConcurrently_ThenReadersSeeWholeValuesAndStableKeys)
+{
+  aisdi::ReadMostlyHashMap<int, std::string> map;
+  for (int i = 0; i < 1000; ++i)
+    map.insert(i, std::to_string(i));
+
+  std::atomic<bool> done(false);
+  std::atomic<int> failures(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; ++t)
+    readers.emplace_back([&map, &done, &failures]() {
+      std::string value;
+      while (!done)
+        for (int i = 0; i < 2000; ++i)
+        {
+          const bool found = map.find(i, value);
+          if (i < 1000 && (!found || (value != std::to_string(i) && value != "x" + std::to_string(i))))
+            ++failures;
+          if (i >= 1000 && found && value != std::to_string(i))
+            ++failures;
+        }
+    });
+
+  // zmiany wartosci, wstawienia z przebudowa tablicy i usuniecia
+  for (int round = 0; round < 5; ++round)
+  {
+    for (int i = 0; i < 1000; ++i)
+      map.insertOrAssign(i, (round % 2 == 0 ? "x" : "") + std::to_string(i));
+    for (int i = 1000; i < 2000; ++i)
+      map.insert(i, std::to_string(i));
+    for (int i = 1000; i < 2000; ++i)
+      map.remove(i);
+  }
+  done = true;
+  for (auto& reader : readers)
+    reader.join();
+
+  BOOST_CHECK_EQUAL(failures.load(), 0);
+  BOOST_CHECK_EQUAL(map.getSize(), 1000u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
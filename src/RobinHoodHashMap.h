@@ -0,0 +1,590 @@
+#ifndef AISDI_MAPS_ROBINHOODHASHMAP_H
+#define AISDI_MAPS_ROBINHOODHASHMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace aisdi
+{
+
+// Adresowanie liniowe metoda Robin Hooda: element dalej od swojego kubelka wypiera
+// element blizszy, wiec wyszukiwanie konczy sie, gdy napotka slot blizej domu niz klucz.
+template <typename KeyType, typename ValueType>
+class RobinHoodHashMap
+{
+public:
+  using key_type = KeyType;
+  using mapped_type = ValueType;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+private:
+  using Slot = typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type;
+
+  // distances[i] == 0 oznacza pusty slot, w przeciwnym razie odleglosc od kubelka + 1
+  static const std::uint8_t MAX_DISTANCE = 255;
+  static const size_type MIN_CAPACITY = 16;
+
+  std::uint8_t* distances;
+  Slot* slots;
+  size_type capacity;
+  size_type counter;
+
+public:
+
+  RobinHoodHashMap(): distances(nullptr), slots(nullptr), capacity(0), counter(0)
+  {}
+
+  explicit RobinHoodHashMap(size_type bucketCount): RobinHoodHashMap()
+  {
+        reserve(bucketCount);
+  }
+
+  RobinHoodHashMap(std::initializer_list<value_type> list):RobinHoodHashMap()
+  {
+        reserve(list.size());
+        for(auto it = list.begin(); it!= list.end(); it++)
+            operator[]((*it).first) = (*it).second;
+  }
+
+  RobinHoodHashMap(const RobinHoodHashMap& other):RobinHoodHashMap()
+  {
+        if(other.capacity == 0)
+            return;
+
+        allocate(other.capacity);
+        for(size_type i = 0; i < capacity; i++)
+        {
+            distances[i] = other.distances[i];
+            if(distances[i] != 0)
+                new (&slots[i]) value_type(other.slotAt(i));
+        }
+        counter = other.counter;
+  }
+
+  RobinHoodHashMap(RobinHoodHashMap&& other) noexcept:
+      distances(other.distances), slots(other.slots), capacity(other.capacity), counter(other.counter)
+  {
+        other.distances = nullptr;
+        other.slots = nullptr;
+        other.capacity = 0;
+        other.counter = 0;
+  }
+
+  RobinHoodHashMap& operator=(const RobinHoodHashMap& other)
+  {
+        if(this != &other)
+        {
+            RobinHoodHashMap temp(other);
+            swap(temp);
+        }
+        return *this;
+  }
+
+  RobinHoodHashMap& operator=(RobinHoodHashMap&& other) noexcept
+  {
+        if(this != &other)
+        {
+            RobinHoodHashMap temp(std::move(other));
+            swap(temp);
+        }
+        return *this;
+  }
+
+  ~RobinHoodHashMap()
+  {
+        eraseHashMap();
+        deallocate();
+  }
+
+  void swap(RobinHoodHashMap& other) noexcept
+  {
+        std::swap(distances, other.distances);
+        std::swap(slots, other.slots);
+        std::swap(capacity, other.capacity);
+        std::swap(counter, other.counter);
+  }
+
+  bool isEmpty() const
+  {
+        return counter == 0;
+  }
+
+  mapped_type& operator[](const key_type& key)
+  {
+        const size_type hash = hashOf(key);
+        size_type index = findIndex(key, hash);
+        if(index != capacity)
+            return slotAt(index).second;
+
+        if((counter + 1) * 10 > capacity * 9)
+            rehash(capacity == 0 ? MIN_CAPACITY : capacity * 2);
+
+        while((index = insertSlot(hash)) == capacity)
+            rehash(capacity * 2);
+
+        new (&slots[index]) value_type(key, mapped_type());
+        counter++;
+        return slotAt(index).second;
+  }
+
+  const mapped_type& valueOf(const key_type& key) const
+  {
+        size_type index = findIndex(key, hashOf(key));
+        if(index == capacity)
+            throw std::out_of_range("valueOf out of range error");
+        return slotAt(index).second;
+  }
+
+  mapped_type& valueOf(const key_type& key)
+  {
+        size_type index = findIndex(key, hashOf(key));
+        if(index == capacity)
+            throw std::out_of_range("valueOf out of range error");
+        return slotAt(index).second;
+  }
+
+  const_iterator find(const key_type& key) const
+  {
+        return const_iterator(this, findIndex(key, hashOf(key)));
+  }
+
+  iterator find(const key_type& key)
+  {
+        return iterator(this, findIndex(key, hashOf(key)));
+  }
+
+  void remove(const key_type& key)
+  {
+        remove(find(key));
+  }
+
+  // usuwanie z przesunieciem wstecz: kolejne elementy przesuwaja sie o jeden slot
+  // blizej domu, dzieki czemu nie sa potrzebne znaczniki usuniecia
+  void remove(const const_iterator& it)
+  {
+        if(it.map != this || it.index >= capacity)
+            throw std::out_of_range("remove out of range");
+
+        const size_type mask = capacity - 1;
+        size_type hole = it.index;
+        slotAt(hole).~value_type();
+
+        size_type next = (hole + 1) & mask;
+        while(distances[next] > 1)
+        {
+            new (&slots[hole]) value_type(std::move(slotAt(next)));
+            slotAt(next).~value_type();
+            distances[hole] = static_cast<std::uint8_t>(distances[next] - 1);
+            hole = next;
+            next = (next + 1) & mask;
+        }
+        distances[hole] = 0;
+        counter--;
+  }
+
+  size_type getSize() const
+  {
+        return counter;
+  }
+
+  size_type bucketCount() const
+  {
+        return capacity;
+  }
+
+  float loadFactor() const
+  {
+        return capacity == 0 ? 0.0f : static_cast<float>(counter) / capacity;
+  }
+
+  // najdluzsza sciezka probkowania (0 - element w swoim kubelku); O(bucketCount)
+  size_type maxProbeLength() const
+  {
+        size_type longest = 0;
+        for(size_type i = 0; i < capacity; i++)
+            if(distances[i] != 0 && static_cast<size_type>(distances[i] - 1) > longest)
+                longest = distances[i] - 1;
+        return longest;
+  }
+
+  // srednia dlugosc sciezki probkowania trafionego wyszukiwania; O(bucketCount)
+  double meanProbeLength() const
+  {
+        if(counter == 0)
+            return 0.0;
+
+        size_type total = 0;
+        for(size_type i = 0; i < capacity; i++)
+            if(distances[i] != 0)
+                total += distances[i] - 1;
+        return static_cast<double>(total) / counter;
+  }
+
+  void reserve(size_type count)
+  {
+        size_type newcapacity = MIN_CAPACITY;
+        while(newcapacity * 9 < count * 10)
+            newcapacity *= 2;
+        if(newcapacity > capacity)
+            rehash(newcapacity);
+  }
+
+  bool operator==(const RobinHoodHashMap& other) const
+  {
+        if(other.counter != counter)
+            return false;
+
+        for(auto it = begin(); it != end(); ++it)
+        {
+            size_type index = other.findIndex(it->first, hashOf(it->first));
+            if(index == other.capacity || other.slotAt(index).second != it->second)
+                return false;
+        }
+        return true;
+  }
+
+  bool operator!=(const RobinHoodHashMap& other) const
+  {
+        return !(*this == other);
+  }
+
+  iterator begin()
+  {
+        return iterator(this, nextFull(0));
+  }
+
+  iterator end()
+  {
+        return iterator(this, capacity);
+  }
+
+  const_iterator cbegin() const
+  {
+        return const_iterator(this, nextFull(0));
+  }
+
+  const_iterator cend() const
+  {
+        return const_iterator(this, capacity);
+  }
+
+  const_iterator begin() const
+  {
+        return cbegin();
+  }
+
+  const_iterator end() const
+  {
+        return cend();
+  }
+
+private:
+
+  static size_type hashOf(const key_type& key)
+  {
+        // std::hash dla liczb to identycznosc, wiec bity trzeba wymieszac
+        std::uint64_t hash = static_cast<std::uint64_t>(std::hash<key_type>()(key));
+        hash *= 0x9E3779B97F4A7C15ull;
+        return static_cast<size_type>(hash ^ (hash >> 32));
+  }
+
+  value_type& slotAt(size_type index)
+  {
+        return *reinterpret_cast<value_type*>(&slots[index]);
+  }
+
+  const value_type& slotAt(size_type index) const
+  {
+        return *reinterpret_cast<const value_type*>(&slots[index]);
+  }
+
+  size_type findIndex(const key_type& key, size_type hash) const
+  {
+        if(capacity == 0)
+            return capacity;
+
+        const size_type mask = capacity - 1;
+        size_type index = hash & mask;
+        unsigned distance = 1;
+
+        // slot blizej domu niz szukany klucz konczy wyszukiwanie
+        while(distances[index] >= distance)
+        {
+            if(distances[index] == distance && slotAt(index).first == key)
+                return index;
+            index = (index + 1) & mask;
+            distance++;
+        }
+        return capacity;
+  }
+
+  // zwalnia slot dla nowego klucza, przesuwajac bogatsze elementy o jeden w prawo;
+  // zwraca capacity, gdy ktoras odleglosc przekroczylaby MAX_DISTANCE
+  size_type insertSlot(size_type hash)
+  {
+        const size_type mask = capacity - 1;
+        size_type index = hash & mask;
+        unsigned distance = 1;
+
+        while(distances[index] >= distance)
+        {
+            index = (index + 1) & mask;
+            distance++;
+        }
+        if(distance >= MAX_DISTANCE)
+            return capacity;
+        if(distances[index] == 0)
+        {
+            distances[index] = static_cast<std::uint8_t>(distance);
+            return index;
+        }
+
+        size_type empty = index;
+        while(distances[empty] != 0)
+        {
+            if(distances[empty] + 1 >= MAX_DISTANCE)
+                return capacity;
+            empty = (empty + 1) & mask;
+        }
+
+        while(empty != index)
+        {
+            const size_type previous = (empty - 1) & mask;
+            new (&slots[empty]) value_type(std::move(slotAt(previous)));
+            slotAt(previous).~value_type();
+            distances[empty] = static_cast<std::uint8_t>(distances[previous] + 1);
+            empty = previous;
+        }
+        distances[index] = static_cast<std::uint8_t>(distance);
+        return index;
+  }
+
+  size_type nextFull(size_type index) const
+  {
+        while(index < capacity && distances[index] == 0)
+            index++;
+        return index < capacity ? index : capacity;
+  }
+
+  // ostatni zajety slot przed index albo capacity, gdy go nie ma
+  size_type prevFull(size_type index) const
+  {
+        while(index > 0)
+        {
+            index--;
+            if(distances[index] != 0)
+                return index;
+        }
+        return capacity;
+  }
+
+  void allocate(size_type slotCount)
+  {
+        distances = new std::uint8_t[slotCount];
+        for(size_type i = 0; i < slotCount; i++)
+            distances[i] = 0;
+        slots = static_cast<Slot*>(::operator new(slotCount * sizeof(Slot)));
+        capacity = slotCount;
+        counter = 0;
+  }
+
+  void deallocate()
+  {
+        delete[] distances;
+        ::operator delete(slots);
+        distances = nullptr;
+        slots = nullptr;
+        capacity = 0;
+  }
+
+  void rehash(size_type slotCount)
+  {
+        RobinHoodHashMap temp;
+        temp.allocate(slotCount);
+        for(size_type i = 0; i < capacity; i++)
+            if(distances[i] != 0)
+                temp.insertMoved(std::move(slotAt(i)));
+        swap(temp);
+  }
+
+  void insertMoved(value_type&& item)
+  {
+        const size_type hash = hashOf(item.first);
+        size_type index;
+        // bardzo zle rozlozone skroty - powiekszamy, az sciezki sie zmieszcza
+        while((index = insertSlot(hash)) == capacity)
+            rehash(capacity * 2);
+        new (&slots[index]) value_type(std::move(item));
+        counter++;
+  }
+
+  void eraseHashMap()
+  {
+        for(size_type i = 0; i < capacity && counter != 0; i++)
+        {
+            if(distances[i] != 0)
+            {
+                slotAt(i).~value_type();
+                distances[i] = 0;
+                counter--;
+            }
+        }
+        counter = 0;
+  }
+};
+
+template <typename KeyType, typename ValueType>
+void swap(RobinHoodHashMap<KeyType, ValueType>& left, RobinHoodHashMap<KeyType, ValueType>& right) noexcept
+{
+  left.swap(right);
+}
+
+template <typename KeyType, typename ValueType>
+class RobinHoodHashMap<KeyType, ValueType>::ConstIterator
+{
+public:
+  using reference = typename RobinHoodHashMap::const_reference;
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename RobinHoodHashMap::value_type;
+  using pointer = const typename RobinHoodHashMap::value_type*;
+
+private:
+  const RobinHoodHashMap* map;
+  size_type index;
+  friend class RobinHoodHashMap;
+
+public:
+
+  explicit ConstIterator(const RobinHoodHashMap* map = nullptr, size_type index = 0): map(map), index(index)
+  {}
+
+  ConstIterator(const ConstIterator& other) : ConstIterator(other.map, other.index)
+  {}
+
+  ConstIterator& operator=(const ConstIterator& other) = default;
+
+  ConstIterator& operator++()
+  {
+    if(map == nullptr || index >= map->capacity)
+        throw std::out_of_range("operator++ out of range");
+    index = map->nextFull(index + 1);
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    auto result = *this;
+    operator++();
+    return result;
+  }
+
+  ConstIterator& operator--()
+  {
+    if(map == nullptr)
+        throw std::out_of_range("operator-- out of range");
+    size_type previous = map->prevFull(index);
+    if(previous == map->capacity)
+        throw std::out_of_range("operator-- out of range");
+    index = previous;
+    return *this;
+  }
+
+  ConstIterator operator--(int)
+  {
+    auto result = *this;
+    operator--();
+    return result;
+  }
+
+  reference operator*() const
+  {
+    if(map == nullptr || index >= map->capacity)
+        throw std::out_of_range("operator* out of range");
+    return map->slotAt(index);
+  }
+
+  pointer operator->() const
+  {
+    return &this->operator*();
+  }
+
+  bool operator==(const ConstIterator& other) const
+  {
+    return map == other.map && index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const
+  {
+    return !(*this == other);
+  }
+};
+
+template <typename KeyType, typename ValueType>
+class RobinHoodHashMap<KeyType, ValueType>::Iterator : public RobinHoodHashMap<KeyType, ValueType>::ConstIterator
+{
+public:
+  using reference = typename RobinHoodHashMap::reference;
+  using pointer = typename RobinHoodHashMap::value_type*;
+
+  explicit Iterator(RobinHoodHashMap* map = nullptr, size_type index = 0) : ConstIterator(map, index)
+  {}
+
+  Iterator(const ConstIterator& other)
+    : ConstIterator(other)
+  {}
+
+  Iterator& operator++()
+  {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int)
+  {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator& operator--()
+  {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int)
+  {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  pointer operator->() const
+  {
+    return &this->operator*();
+  }
+
+  reference operator*() const
+  {
+    // ugly cast, yet reduces code duplication.
+    return const_cast<reference>(ConstIterator::operator*());
+  }
+};
+
+}
+
+#endif /* AISDI_MAPS_ROBINHOODHASHMAP_H */
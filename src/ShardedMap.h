@@ -0,0 +1,226 @@
+#ifndef AISDI_MAPS_SHARDEDMAP_H
+#define AISDI_MAPS_SHARDEDMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "ThreadPool.h"
+
+namespace aisdi
+{
+
+// Nakladka dzielaca klucze miedzy N niezaleznych map (HashMap, TreeMap, ...), kazda z wlasna
+// blokada. Watki zmieniajace rozne czesci (shard) nie czekaja na siebie, a mniejsze mapy lepiej
+// mieszcza sie w pamieci podrecznej. Wyniki zwracane sa przez kopie - referencja do wartosci
+// przezylaby zwolnienie blokady. Operacje na calej mapie (getSize, clear) nie sa atomowe
+// wzgledem rownoleglych zmian.
+template <typename MapType, std::size_t N,
+          typename Hash = std::hash<typename MapType::key_type>>
+class ShardedMap
+{
+  static_assert(N > 0, "ShardedMap needs at least one shard");
+
+public:
+  using map_type = MapType;
+  using key_type = typename MapType::key_type;
+  using mapped_type = typename MapType::mapped_type;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+
+  class ValueReference;
+
+  static const size_type SHARD_COUNT = N;
+
+private:
+    // blokady i mapy w osobnych liniach pamieci podrecznej, zeby czesci nie rywalizowaly o jedna linie
+    class Shard
+    {
+         public:
+        mutable std::mutex lock;
+        MapType map;
+        char padding[64];
+    };
+
+    hasher hash_function;
+    Shard shards[N];
+
+public:
+
+  ShardedMap(): hash_function()
+  {}
+
+  explicit ShardedMap(const hasher& hash): hash_function(hash)
+  {}
+
+  ShardedMap(std::initializer_list<value_type> list): ShardedMap()
+  {
+        for(auto it = list.begin(); it != list.end(); it++)
+            insertOrAssign((*it).first, (*it).second);
+  }
+
+  ShardedMap(const ShardedMap&) = delete;
+  ShardedMap& operator=(const ShardedMap&) = delete;
+
+  bool isEmpty() const
+  {
+        return getSize() == 0;
+  }
+
+  size_type getSize() const
+  {
+        size_type result = 0;
+        for(const Shard& shard : shards)
+        {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            result += shard.map.getSize();
+        }
+        return result;
+  }
+
+  // numer czesci, do ktorej trafia klucz
+  size_type shardOf(const key_type& key) const
+  {
+        // mapy w czesciach biora gorne bity iloczynu Fibonacciego, wiec czesc wybieramy
+        // bitami dolnymi - inaczej kazda czesc uzywalaby tylko wycinka swoich kubelkow
+        const std::uint64_t mixed = static_cast<std::uint64_t>(hash_function(key)) * 11400714819323198485ull;
+        return static_cast<size_type>((mixed ^ (mixed >> 32)) % N);
+  }
+
+  // map[key] = value wstawia albo nadpisuje wartosc; odczyt map[key] dodaje brakujacy klucz
+  // z wartoscia domyslna, tak jak w HashMap
+  ValueReference operator[](const key_type& key)
+  {
+        return ValueReference(*this, key);
+  }
+
+  bool contains(const key_type& key) const
+  {
+        const Shard& shard = shards[shardOf(key)];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        return shard.map.find(key) != shard.map.end();
+  }
+
+  // kopiuje wartosc do result; false, gdy klucza nie ma
+  bool find(const key_type& key, mapped_type& result) const
+  {
+        const Shard& shard = shards[shardOf(key)];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        auto it = shard.map.find(key);
+        if(it == shard.map.end())
+            return false;
+        result = it->second;
+        return true;
+  }
+
+  mapped_type valueOf(const key_type& key) const
+  {
+        mapped_type result;
+        if(!find(key, result))
+            throw std::out_of_range("valueOf out of range error");
+        return result;
+  }
+
+  // dodaje pare, jesli klucza nie ma; istniejaca wartosc zostaje bez zmian
+  bool insert(const key_type& key, const mapped_type& mapped)
+  {
+        Shard& shard = shards[shardOf(key)];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        if(shard.map.find(key) != shard.map.end())
+            return false;
+        shard.map[key] = mapped;
+        return true;
+  }
+
+  // zwraca true, gdy klucz zostal dodany, false, gdy nadpisano wartosc
+  bool insertOrAssign(const key_type& key, const mapped_type& mapped)
+  {
+        Shard& shard = shards[shardOf(key)];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        const size_type before = shard.map.getSize();
+        shard.map[key] = mapped;
+        return shard.map.getSize() != before;
+  }
+
+  bool remove(const key_type& key)
+  {
+        Shard& shard = shards[shardOf(key)];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        auto it = shard.map.find(key);
+        if(it == shard.map.end())
+            return false;
+        shard.map.remove(it);
+        return true;
+  }
+
+  void clear()
+  {
+        for(Shard& shard : shards)
+        {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            shard.map = MapType();
+        }
+  }
+
+  // wywoluje fn(index, map) dla kazdej czesci pod jej blokada, rownolegle w watkach puli;
+  // pierwszy wyjatek z fn jest rzucany dalej po zakonczeniu wszystkich czesci
+  template <typename Function>
+  void forEachShard(Function fn, ThreadPool& pool = ThreadPool::instance())
+  {
+        pool.parallelFor(N, [this, &fn](size_type index) {
+            std::lock_guard<std::mutex> guard(shards[index].lock);
+            fn(index, shards[index].map);
+        });
+  }
+
+  template <typename Function>
+  void forEachShard(Function fn, ThreadPool& pool = ThreadPool::instance()) const
+  {
+        pool.parallelFor(N, [this, &fn](size_type index) {
+            std::lock_guard<std::mutex> guard(shards[index].lock);
+            fn(index, static_cast<const MapType&>(shards[index].map));
+        });
+  }
+};
+
+template <typename MapType, std::size_t N, typename Hash>
+const std::size_t ShardedMap<MapType, N, Hash>::SHARD_COUNT;
+
+template <typename MapType, std::size_t N, typename Hash>
+class ShardedMap<MapType, N, Hash>::ValueReference
+{
+public:
+  ValueReference(ShardedMap& map, const key_type& key): map(map), key(key)
+  {}
+
+  ValueReference& operator=(const mapped_type& mapped)
+  {
+    map.insertOrAssign(key, mapped);
+    return *this;
+  }
+
+  ValueReference& operator=(const ValueReference& other)
+  {
+    return *this = static_cast<mapped_type>(other);
+  }
+
+  operator mapped_type() const
+  {
+    Shard& shard = map.shards[map.shardOf(key)];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.map[key];
+  }
+
+private:
+  ShardedMap& map;
+  const key_type key;
+};
+
+}
+
+#endif /* AISDI_MAPS_SHARDEDMAP_H */
@@ -0,0 +1,147 @@
+#include <ShardedMap.h>
+#include <HashMap.h>
+#include <TreeMap.h>
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedMapTypes = boost::mpl::list<aisdi::ShardedMap<aisdi::HashMap<std::int32_t, std::string>, 8>,
+                                        aisdi::ShardedMap<aisdi::TreeMap<std::uint64_t, std::string>, 3>>;
+
+BOOST_AUTO_TEST_SUITE(ShardedMapsTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              Map,
+                              TestedMapTypes)
+{
+  const Map map;
+
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(!map.contains(0));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInitializingFromListOfPairs_ThenAllItemsAreInMap,
+                              Map,
+                              TestedMapTypes)
+{
+  const Map map = { { 753, "Rome" }, { 1789, "Paris" } };
+  std::string value;
+
+  BOOST_CHECK_EQUAL(map.getSize(), 2u);
+  BOOST_CHECK_EQUAL(map.valueOf(753), "Rome");
+  BOOST_CHECK(map.find(1789, value));
+  BOOST_CHECK_EQUAL(value, "Paris");
+  BOOST_CHECK(!map.find(1410, value));
+  BOOST_CHECK_THROW(map.valueOf(1410), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenUsingIndexOperator_ThenItemsAreAddedOrAssigned,
+                              Map,
+                              TestedMapTypes)
+{
+  Map map;
+
+  map[42] = "Alice";
+  map[42] = "Bob";
+  const std::string missing = map[27];
+
+  BOOST_CHECK(missing.empty());
+  BOOST_CHECK_EQUAL(map.getSize(), 2u);
+  BOOST_CHECK_EQUAL(map.valueOf(42), "Bob");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenInsertingAndRemoving_ThenResultsTellWhatChanged,
+                              Map,
+                              TestedMapTypes)
+{
+  Map map = { { 42, "Alice" } };
+
+  BOOST_CHECK(!map.insert(42, "Bob"));
+  BOOST_CHECK_EQUAL(map.valueOf(42), "Alice");
+  BOOST_CHECK(!map.insertOrAssign(42, "Bob"));
+  BOOST_CHECK(map.insertOrAssign(43, "Chuck"));
+  BOOST_CHECK(map.remove(42));
+  BOOST_CHECK(!map.remove(42));
+  BOOST_CHECK_EQUAL(map.getSize(), 1u);
+
+  map.clear();
+  BOOST_CHECK(map.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyKeys_WhenVisitingShards_ThenEachKeyIsInItsOwnShardOnce,
+                              Map,
+                              TestedMapTypes)
+{
+  Map map;
+  for (int i = 0; i < 1000; ++i)
+    map.insert(i, std::to_string(i));
+
+  std::atomic<int> visited(0);
+  std::atomic<int> misplaced(0);
+  std::vector<std::size_t> sizes(Map::SHARD_COUNT, 0);
+  map.forEachShard([&](std::size_t index, const typename Map::map_type& shard) {
+    sizes[index] = shard.getSize();
+    for (const auto& item : shard)
+    {
+      ++visited;
+      if (map.shardOf(item.first) != index)
+        ++misplaced;
+    }
+  });
+
+  BOOST_CHECK_EQUAL(visited.load(), 1000);
+  BOOST_CHECK_EQUAL(misplaced.load(), 0);
+  for (std::size_t size : sizes)
+    BOOST_CHECK_GT(size, 0u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenShardWork_WhenItThrows_ThenExceptionReachesCallerAfterAllShards,
+                              Map,
+                              TestedMapTypes)
+{
+  Map map = { { 1, "a" } };
+  std::atomic<std::size_t> calls(0);
+
+  BOOST_CHECK_THROW(map.forEachShard([&calls](std::size_t index, typename Map::map_type&) {
+                      ++calls;
+                      if (index == 0)
+                        throw std::runtime_error("shard failed");
+                    }),
+                    std::runtime_error);
+  BOOST_CHECK_EQUAL(calls.load(), Map::SHARD_COUNT);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyThreads_WhenWritingConcurrently_ThenNoUpdateIsLost,
+                              Map,
+                              TestedMapTypes)
+{
+  Map map;
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&map, t]() {
+      for (int i = 0; i < 2000; ++i)
+      {
+        map.insert(i * 4 + t, "x");
+        map[i * 4 + t] = std::to_string(i);
+        if (i % 2 == 1)
+          map.remove(i * 4 + t);
+      }
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  BOOST_CHECK_EQUAL(map.getSize(), 4000u);
+  for (int i = 0; i < 8000; ++i)
+    BOOST_CHECK_EQUAL(map.contains(i), (i / 4) % 2 == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,685 @@
+#ifndef AISDI_MAPS_SWISSHASHMAP_H
+#define AISDI_MAPS_SWISSHASHMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AISDI_MAPS_SWISS_SSE2 1
+#endif
+
+namespace aisdi
+{
+
+// Tablica z adresowaniem otwartym: jeden bajt kontrolny na slot (7 bitow skrotu
+// albo znacznik pusty/usuniety), przeszukiwane grupami po 16 slotow.
+template <typename KeyType, typename ValueType>
+class SwissHashMap
+{
+public:
+  using key_type = KeyType;
+  using mapped_type = ValueType;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+private:
+  using ctrl_t = std::int8_t;
+  using Slot = typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type;
+
+  static const ctrl_t EMPTY = -128;
+  static const ctrl_t DELETED = -2;
+  static const size_type GROUP_SIZE = 16;
+
+  static unsigned countTrailingZeros(std::uint32_t bits)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<unsigned>(__builtin_ctz(bits));
+#else
+      unsigned count = 0;
+      while((bits & 1u) == 0)
+      {
+          bits >>= 1;
+          count++;
+      }
+      return count;
+#endif
+  }
+
+  static unsigned countLeadingZeros(std::uint32_t bits)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<unsigned>(__builtin_clz(bits));
+#else
+      unsigned count = 0;
+      while((bits & 0x80000000u) == 0)
+      {
+          bits <<= 1;
+          count++;
+      }
+      return count;
+#endif
+  }
+
+  // 16 bajtow kontrolnych porownywanych naraz; wynik to maska bitowa slotow
+  class Group
+  {
+  public:
+#ifdef AISDI_MAPS_SWISS_SSE2
+      __m128i ctrl;
+
+      explicit Group(const ctrl_t* pos):
+          ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))){}
+
+      std::uint32_t match(ctrl_t h2) const
+      {
+          return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+      }
+
+      std::uint32_t matchEmpty() const
+      {
+          return match(EMPTY);
+      }
+
+      std::uint32_t matchEmptyOrDeleted() const
+      {
+          return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl)));
+      }
+#else
+      const ctrl_t* ctrl;
+
+      explicit Group(const ctrl_t* pos): ctrl(pos){}
+
+      std::uint32_t match(ctrl_t h2) const
+      {
+          std::uint32_t bits = 0;
+          for(size_type i = 0; i < GROUP_SIZE; i++)
+              if(ctrl[i] == h2)
+                  bits |= 1u << i;
+          return bits;
+      }
+
+      std::uint32_t matchEmpty() const
+      {
+          return match(EMPTY);
+      }
+
+      std::uint32_t matchEmptyOrDeleted() const
+      {
+          std::uint32_t bits = 0;
+          for(size_type i = 0; i < GROUP_SIZE; i++)
+              if(ctrl[i] < -1)
+                  bits |= 1u << i;
+          return bits;
+      }
+#endif
+
+      std::uint32_t matchFull() const
+      {
+          return ~matchEmptyOrDeleted() & 0xFFFFu;
+      }
+  };
+
+  ctrl_t* ctrl;
+  Slot* slots;
+  size_type capacity;
+  size_type counter;
+  size_type growth_left;
+
+public:
+
+  SwissHashMap(): ctrl(nullptr), slots(nullptr), capacity(0), counter(0), growth_left(0)
+  {}
+
+  explicit SwissHashMap(size_type bucketCount): SwissHashMap()
+  {
+        reserve(bucketCount);
+  }
+
+  SwissHashMap(std::initializer_list<value_type> list):SwissHashMap()
+  {
+        reserve(list.size());
+        for(auto it = list.begin(); it!= list.end(); it++)
+            operator[]((*it).first) = (*it).second;
+  }
+
+  SwissHashMap(const SwissHashMap& other):SwissHashMap()
+  {
+        if(other.capacity == 0)
+            return;
+
+        allocate(other.capacity);
+        for(size_type i = 0; i < capacity; i++)
+        {
+            ctrl[i] = other.ctrl[i];
+            if(isFull(ctrl[i]))
+                new (&slots[i]) value_type(other.slotAt(i));
+        }
+        counter = other.counter;
+        growth_left = other.growth_left;
+  }
+
+  SwissHashMap(SwissHashMap&& other) noexcept:
+      ctrl(other.ctrl), slots(other.slots), capacity(other.capacity), counter(other.counter), growth_left(other.growth_left)
+  {
+        other.ctrl = nullptr;
+        other.slots = nullptr;
+        other.capacity = 0;
+        other.counter = 0;
+        other.growth_left = 0;
+  }
+
+  SwissHashMap& operator=(const SwissHashMap& other)
+  {
+        if(this != &other)
+        {
+            SwissHashMap temp(other);
+            swap(temp);
+        }
+        return *this;
+  }
+
+  SwissHashMap& operator=(SwissHashMap&& other) noexcept
+  {
+        if(this != &other)
+        {
+            SwissHashMap temp(std::move(other));
+            swap(temp);
+        }
+        return *this;
+  }
+
+  ~SwissHashMap()
+  {
+        eraseHashMap();
+        deallocate();
+  }
+
+  void swap(SwissHashMap& other) noexcept
+  {
+        std::swap(ctrl, other.ctrl);
+        std::swap(slots, other.slots);
+        std::swap(capacity, other.capacity);
+        std::swap(counter, other.counter);
+        std::swap(growth_left, other.growth_left);
+  }
+
+  bool isEmpty() const
+  {
+        return counter == 0;
+  }
+
+  mapped_type& operator[](const key_type& key)
+  {
+        const std::uint64_t hash = hashOf(key);
+        size_type index = findIndex(key, hash);
+        if(index != capacity)
+            return slotAt(index).second;
+
+        if(growth_left == 0)
+        {
+            // same rozmiarowe przebudowanie wystarczy, gdy miejsce zajmuja tylko znaczniki usuniecia
+            rehash(counter + 1 > maxLoad(capacity) / 2 ? (capacity == 0 ? GROUP_SIZE : capacity * 2) : capacity);
+        }
+
+        index = findInsertSlot(hash);
+        if(ctrl[index] == EMPTY)
+            growth_left--;
+        new (&slots[index]) value_type(key, mapped_type());
+        ctrl[index] = h2(hash);
+        counter++;
+        return slotAt(index).second;
+  }
+
+  const mapped_type& valueOf(const key_type& key) const
+  {
+        size_type index = findIndex(key, hashOf(key));
+        if(index == capacity)
+            throw std::out_of_range("valueOf out of range error");
+        return slotAt(index).second;
+  }
+
+  mapped_type& valueOf(const key_type& key)
+  {
+        size_type index = findIndex(key, hashOf(key));
+        if(index == capacity)
+            throw std::out_of_range("valueOf out of range error");
+        return slotAt(index).second;
+  }
+
+  const_iterator find(const key_type& key) const
+  {
+        return const_iterator(this, findIndex(key, hashOf(key)));
+  }
+
+  iterator find(const key_type& key)
+  {
+        return iterator(this, findIndex(key, hashOf(key)));
+  }
+
+  void remove(const key_type& key)
+  {
+        remove(find(key));
+  }
+
+  void remove(const const_iterator& it)
+  {
+        if(it.map != this || it.index >= capacity)
+            throw std::out_of_range("remove out of range");
+
+        const size_type index = it.index;
+        slotAt(index).~value_type();
+        counter--;
+
+        // slot moze byc znowu pusty tylko wtedy, gdy zadne wyszukiwanie nie przeszlo przez jego grupe
+        const size_type group = index & ~(GROUP_SIZE - 1);
+        if(Group(ctrl + group).matchEmpty() != 0)
+        {
+            ctrl[index] = EMPTY;
+            growth_left++;
+        }
+        else
+            ctrl[index] = DELETED;
+  }
+
+  size_type getSize() const
+  {
+        return counter;
+  }
+
+  size_type bucketCount() const
+  {
+        return capacity;
+  }
+
+  float loadFactor() const
+  {
+        return capacity == 0 ? 0.0f : static_cast<float>(counter) / capacity;
+  }
+
+  void reserve(size_type count)
+  {
+        size_type newcapacity = GROUP_SIZE;
+        while(maxLoad(newcapacity) < count)
+            newcapacity *= 2;
+        if(newcapacity > capacity)
+            rehash(newcapacity);
+  }
+
+  bool operator==(const SwissHashMap& other) const
+  {
+        if(other.counter != counter)
+            return false;
+
+        for(auto it = begin(); it != end(); ++it)
+        {
+            size_type index = other.findIndex(it->first, hashOf(it->first));
+            if(index == other.capacity || other.slotAt(index).second != it->second)
+                return false;
+        }
+        return true;
+  }
+
+  bool operator!=(const SwissHashMap& other) const
+  {
+        return !(*this == other);
+  }
+
+  iterator begin()
+  {
+        return iterator(this, nextFull(0));
+  }
+
+  iterator end()
+  {
+        return iterator(this, capacity);
+  }
+
+  const_iterator cbegin() const
+  {
+        return const_iterator(this, nextFull(0));
+  }
+
+  const_iterator cend() const
+  {
+        return const_iterator(this, capacity);
+  }
+
+  const_iterator begin() const
+  {
+        return cbegin();
+  }
+
+  const_iterator end() const
+  {
+        return cend();
+  }
+
+private:
+
+  static bool isFull(ctrl_t c)
+  {
+        return c >= 0;
+  }
+
+  static size_type maxLoad(size_type slotCount)
+  {
+        return slotCount - slotCount / 8;
+  }
+
+  static std::uint64_t hashOf(const key_type& key)
+  {
+        // std::hash dla liczb to identycznosc, wiec bity trzeba wymieszac
+        std::uint64_t hash = static_cast<std::uint64_t>(std::hash<key_type>()(key));
+        hash *= 0x9E3779B97F4A7C15ull;
+        return hash ^ (hash >> 32);
+  }
+
+  static ctrl_t h2(std::uint64_t hash)
+  {
+        return static_cast<ctrl_t>(hash & 0x7F);
+  }
+
+  static std::uint64_t h1(std::uint64_t hash)
+  {
+        return hash >> 7;
+  }
+
+  value_type& slotAt(size_type index)
+  {
+        return *reinterpret_cast<value_type*>(&slots[index]);
+  }
+
+  const value_type& slotAt(size_type index) const
+  {
+        return *reinterpret_cast<const value_type*>(&slots[index]);
+  }
+
+  size_type findIndex(const key_type& key, std::uint64_t hash) const
+  {
+        if(capacity == 0)
+            return capacity;
+
+        const size_type groupmask = capacity / GROUP_SIZE - 1;
+        size_type group = static_cast<size_type>(h1(hash)) & groupmask;
+        const ctrl_t fingerprint = h2(hash);
+
+        for(size_type step = 1; step <= groupmask + 1; step++)
+        {
+            const size_type base = group * GROUP_SIZE;
+            Group current(ctrl + base);
+            std::uint32_t bits = current.match(fingerprint);
+            while(bits != 0)
+            {
+                const size_type index = base + countTrailingZeros(bits);
+                if(slotAt(index).first == key)
+                    return index;
+                bits &= bits - 1;
+            }
+            if(current.matchEmpty() != 0)
+                return capacity;
+            group = (group + step) & groupmask;
+        }
+        return capacity;
+  }
+
+  size_type findInsertSlot(std::uint64_t hash) const
+  {
+        const size_type groupmask = capacity / GROUP_SIZE - 1;
+        size_type group = static_cast<size_type>(h1(hash)) & groupmask;
+
+        for(size_type step = 1; ; step++)
+        {
+            const size_type base = group * GROUP_SIZE;
+            std::uint32_t bits = Group(ctrl + base).matchEmptyOrDeleted();
+            if(bits != 0)
+                return base + countTrailingZeros(bits);
+            group = (group + step) & groupmask;
+        }
+  }
+
+  size_type nextFull(size_type index) const
+  {
+        while(index < capacity)
+        {
+            const size_type base = index & ~(GROUP_SIZE - 1);
+            std::uint32_t bits = Group(ctrl + base).matchFull() >> (index - base);
+            if(bits != 0)
+                return index + countTrailingZeros(bits);
+            index = base + GROUP_SIZE;
+        }
+        return capacity;
+  }
+
+  // ostatni zajety slot przed index albo capacity, gdy go nie ma
+  size_type prevFull(size_type index) const
+  {
+        while(index > 0)
+        {
+            const size_type base = (index - 1) & ~(GROUP_SIZE - 1);
+            std::uint32_t bits = Group(ctrl + base).matchFull() & ((1u << (index - base)) - 1);
+            if(bits != 0)
+                return base + 31 - countLeadingZeros(bits);
+            index = base;
+        }
+        return capacity;
+  }
+
+  void allocate(size_type slotCount)
+  {
+        ctrl = new ctrl_t[slotCount];
+        for(size_type i = 0; i < slotCount; i++)
+            ctrl[i] = EMPTY;
+        slots = static_cast<Slot*>(::operator new(slotCount * sizeof(Slot)));
+        capacity = slotCount;
+        counter = 0;
+        growth_left = maxLoad(slotCount);
+  }
+
+  void deallocate()
+  {
+        delete[] ctrl;
+        ::operator delete(slots);
+        ctrl = nullptr;
+        slots = nullptr;
+        capacity = 0;
+        growth_left = 0;
+  }
+
+  void rehash(size_type slotCount)
+  {
+        ctrl_t* oldctrl = ctrl;
+        Slot* oldslots = slots;
+        const size_type oldcapacity = capacity;
+        const size_type oldcounter = counter;
+
+        allocate(slotCount);
+        for(size_type i = 0; i < oldcapacity; i++)
+        {
+            if(!isFull(oldctrl[i]))
+                continue;
+
+            value_type& old = *reinterpret_cast<value_type*>(&oldslots[i]);
+            const std::uint64_t hash = hashOf(old.first);
+            const size_type index = findInsertSlot(hash);
+            new (&slots[index]) value_type(std::move(old));
+            ctrl[index] = h2(hash);
+            old.~value_type();
+        }
+        counter = oldcounter;
+        growth_left -= counter;
+
+        delete[] oldctrl;
+        ::operator delete(oldslots);
+  }
+
+  void eraseHashMap()
+  {
+        for(size_type i = 0; i < capacity && counter != 0; i++)
+        {
+            if(isFull(ctrl[i]))
+            {
+                slotAt(i).~value_type();
+                ctrl[i] = EMPTY;
+                counter--;
+            }
+        }
+        counter = 0;
+        growth_left = maxLoad(capacity);
+  }
+};
+
+template <typename KeyType, typename ValueType>
+void swap(SwissHashMap<KeyType, ValueType>& left, SwissHashMap<KeyType, ValueType>& right) noexcept
+{
+  left.swap(right);
+}
+
+template <typename KeyType, typename ValueType>
+class SwissHashMap<KeyType, ValueType>::ConstIterator
+{
+public:
+  using reference = typename SwissHashMap::const_reference;
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename SwissHashMap::value_type;
+  using pointer = const typename SwissHashMap::value_type*;
+
+private:
+  const SwissHashMap* map;
+  size_type index;
+  friend class SwissHashMap;
+
+public:
+
+  explicit ConstIterator(const SwissHashMap* map = nullptr, size_type index = 0): map(map), index(index)
+  {}
+
+  ConstIterator(const ConstIterator& other) : ConstIterator(other.map, other.index)
+  {}
+
+  ConstIterator& operator=(const ConstIterator& other) = default;
+
+  ConstIterator& operator++()
+  {
+    if(map == nullptr || index >= map->capacity)
+        throw std::out_of_range("operator++ out of range");
+    index = map->nextFull(index + 1);
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    auto result = *this;
+    operator++();
+    return result;
+  }
+
+  ConstIterator& operator--()
+  {
+    if(map == nullptr)
+        throw std::out_of_range("operator-- out of range");
+    size_type previous = map->prevFull(index);
+    if(previous == map->capacity)
+        throw std::out_of_range("operator-- out of range");
+    index = previous;
+    return *this;
+  }
+
+  ConstIterator operator--(int)
+  {
+    auto result = *this;
+    operator--();
+    return result;
+  }
+
+  reference operator*() const
+  {
+    if(map == nullptr || index >= map->capacity)
+        throw std::out_of_range("operator* out of range");
+    return map->slotAt(index);
+  }
+
+  pointer operator->() const
+  {
+    return &this->operator*();
+  }
+
+  bool operator==(const ConstIterator& other) const
+  {
+    return map == other.map && index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const
+  {
+    return !(*this == other);
+  }
+};
+
+template <typename KeyType, typename ValueType>
+class SwissHashMap<KeyType, ValueType>::Iterator : public SwissHashMap<KeyType, ValueType>::ConstIterator
+{
+public:
+  using reference = typename SwissHashMap::reference;
+  using pointer = typename SwissHashMap::value_type*;
+
+  explicit Iterator(SwissHashMap* map = nullptr, size_type index = 0) : ConstIterator(map, index)
+  {}
+
+  Iterator(const ConstIterator& other)
+    : ConstIterator(other)
+  {}
+
+  Iterator& operator++()
+  {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int)
+  {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator& operator--()
+  {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int)
+  {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  pointer operator->() const
+  {
+    return &this->operator*();
+  }
+
+  reference operator*() const
+  {
+    // ugly cast, yet reduces code duplication.
+    return const_cast<reference>(ConstIterator::operator*());
+  }
+};
+
+}
+
+#endif /* AISDI_MAPS_SWISSHASHMAP_H */
@@ -0,0 +1,393 @@
+#ifndef AISDI_MAPS_THREADPOOL_H
+#define AISDI_MAPS_THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+// wynik czesciowy zadania we wlasnej linii pamieci podrecznej - watki nie pisza do wspolnej linii;
+// value przed pierwszym add() to tylko kopia zastepcza
+template <typename T>
+class PartialResult
+{
+public:
+  T value;
+  bool filled;
+  char padding[64];
+
+  explicit PartialResult(const T& placeholder): value(placeholder), filled(false)
+  {}
+
+  template <typename Combine>
+  void add(T item, Combine& combine)
+  {
+      value = filled ? combine(std::move(value), std::move(item)) : std::move(item);
+      filled = true;
+  }
+};
+
+}
+
+// Mala pula watkow z podkradaniem pracy. Kazdy watek ma wlasna kolejke: swoje zadania bierze
+// od konca (najswiezsze, cieple w pamieci podrecznej), a gdy jej zabraknie, podkrada z poczatku
+// kolejek innych. Zadania zlecone spoza puli trafiaja do osobnej kolejki wspolnej.
+// Watek czekajacy na TaskGroup sam wykonuje zadania, wiec zagniezdzone grupy nie blokuja puli,
+// a pula bez watkow roboczych (jeden rdzen) wykonuje wszystko w watku wolajacym.
+class ThreadPool
+{
+public:
+  using size_type = std::size_t;
+  using Task = std::function<void()>;
+
+  class TaskGroup;
+
+  // ile zadan na watek tworza operacje rownolegle na mapach - kilka, zeby bylo co podkradac
+  static const size_type TASKS_PER_THREAD = 4;
+
+  // watek wolajacy tez pracuje, wiec domyslnie o jeden watek roboczy mniej niz rdzeni
+  explicit ThreadPool(size_type workerCount = defaultWorkerCount()): pending(0), stopping(false)
+  {
+        for(size_type i = 0; i <= workerCount; i++)
+            queues.emplace_back(new Queue());
+        try
+        {
+            for(size_type i = 0; i < workerCount; i++)
+                workers.emplace_back(&ThreadPool::work, this, i);
+        }
+        catch(...)
+        {
+            stop();
+            throw;
+        }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // czeka na zadania, ktore sa juz w kolejkach
+  ~ThreadPool()
+  {
+        stop();
+  }
+
+  static ThreadPool& instance()
+  {
+        static ThreadPool pool;
+        return pool;
+  }
+
+  static size_type defaultWorkerCount()
+  {
+        const size_type cores = std::thread::hardware_concurrency();
+        return cores > 1 ? cores - 1 : 0;
+  }
+
+  size_type getWorkerCount() const
+  {
+        return workers.size();
+  }
+
+  // na ile czesci dzielic prace, zeby zajac wszystkie watki razem z wolajacym
+  size_type splitCount() const
+  {
+        return (workers.size() + 1) * TASKS_PER_THREAD;
+  }
+
+  void submit(Task task)
+  {
+        Queue& queue = *queues[currentQueue()];
+        {
+            std::lock_guard<std::mutex> guard(queue.lock);
+            queue.tasks.push_back(std::move(task));
+            pending.fetch_add(1);//pod blokada kolejki, wiec zdjecie zadania nie wyprzedzi licznika
+        }
+        {
+            std::lock_guard<std::mutex> guard(sleep_lock);
+        }
+        wake.notify_one();
+  }
+
+  // wykonuje fn(i) dla i z [0, count) i czeka na wszystkie; pierwszy wyjatek jest rzucany dalej
+  template <typename Function>
+  void parallelFor(size_type count, const Function& fn);
+
+private:
+    // kolejki w osobnych liniach pamieci podrecznej
+    class Queue
+    {
+         public:
+        std::mutex lock;
+        std::deque<Task> tasks;
+        char padding[64];
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;//ostatnia dla watkow spoza puli
+    std::vector<std::thread> workers;
+    std::atomic<size_type> pending;//zadania w kolejkach
+    std::mutex sleep_lock;
+    std::condition_variable wake;
+    bool stopping;
+
+  // numer watku roboczego w puli, ktora go uruchomila
+  static const ThreadPool*& currentPool()
+  {
+      static thread_local const ThreadPool* pool = nullptr;
+      return pool;
+  }
+
+  static size_type& currentIndex()
+  {
+      static thread_local size_type index = 0;
+      return index;
+  }
+
+  size_type currentQueue() const
+  {
+      return currentPool() == this ? currentIndex() : queues.size() - 1;
+  }
+
+  bool takeOwn(Queue& queue, Task& task)
+  {
+      std::lock_guard<std::mutex> guard(queue.lock);
+      if(queue.tasks.empty())
+          return false;
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      return true;
+  }
+
+  bool steal(Queue& queue, Task& task)
+  {
+      std::lock_guard<std::mutex> guard(queue.lock);
+      if(queue.tasks.empty())
+          return false;
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+  }
+
+  // wykonuje jedno zadanie: najpierw z wlasnej kolejki, potem podkradzione; false, gdy nie ma zadnego
+  bool runOne()
+  {
+      if(pending.load() == 0)
+          return false;
+
+      const size_type self = currentQueue();
+      Task task;
+      bool found = takeOwn(*queues[self], task);
+      for(size_type i = 1; !found && i < queues.size(); i++)
+          found = steal(*queues[(self + i) % queues.size()], task);
+      if(!found)
+          return false;
+
+      pending.fetch_sub(1);
+      task();
+      return true;
+  }
+
+  void work(size_type index)
+  {
+      currentPool() = this;
+      currentIndex() = index;
+      while(true)
+      {
+          if(runOne())
+              continue;
+
+          std::unique_lock<std::mutex> guard(sleep_lock);
+          wake.wait(guard, [this]() { return stopping || pending.load() != 0; });
+          if(stopping && pending.load() == 0)
+              return;
+      }
+  }
+
+  void stop()
+  {
+      {
+          std::lock_guard<std::mutex> guard(sleep_lock);
+          stopping = true;
+      }
+      wake.notify_all();
+      for(auto& worker : workers)
+          worker.join();
+      workers.clear();
+  }
+};
+
+// Zbior zadan, na ktory mozna poczekac. Czekajacy watek wykonuje w tym czasie zadania z puli.
+class ThreadPool::TaskGroup
+{
+public:
+  explicit TaskGroup(ThreadPool& pool): pool(pool), remaining(0)
+  {}
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  // grupa nie moze zniknac przed swoimi zadaniami; wyjatek zostaje wtedy pominiety
+  ~TaskGroup()
+  {
+      finish();
+  }
+
+  template <typename Function>
+  void run(Function fn)
+  {
+      remaining.fetch_add(1);
+      try
+      {
+          pool.submit([this, fn]() {
+              try
+              {
+                  fn();
+              }
+              catch(...)
+              {
+                  std::lock_guard<std::mutex> guard(error_lock);
+                  if(!error)
+                      error = std::current_exception();
+              }
+              remaining.fetch_sub(1);
+          });
+      }
+      catch(...)
+      {
+          remaining.fetch_sub(1);
+          throw;
+      }
+  }
+
+  // czeka na wszystkie zadania i rzuca dalej pierwszy wyjatek z nich
+  void wait()
+  {
+      finish();
+      std::exception_ptr result;
+      {
+          std::lock_guard<std::mutex> guard(error_lock);
+          std::swap(result, error);
+      }
+      if(result)
+          std::rethrow_exception(result);
+  }
+
+private:
+  ThreadPool& pool;
+  std::atomic<size_type> remaining;
+  std::mutex error_lock;
+  std::exception_ptr error;
+
+  void finish()
+  {
+      while(remaining.load() != 0)
+          if(!pool.runOne())
+              std::this_thread::yield();
+  }
+};
+
+template <typename Function>
+void ThreadPool::parallelFor(size_type count, const Function& fn)
+{
+  TaskGroup group(*this);
+  for(size_type i = 0; i < count; i++)
+      group.run([&fn, i]() { fn(i); });
+  group.wait();
+}
+
+namespace detail
+{
+
+// scala posortowane [lo, mid) i [mid, hi) z items do buffer w kilku niezaleznych czesciach:
+// punkty podzialu w lewej polowie, odpowiadajace im w prawej z lower_bound - elementy rowne
+// zostaja za tymi z lewej, wiec scalanie pozostaje stabilne
+template <typename T, typename Less>
+void mergeInParts(std::vector<T>& items, std::vector<T>& buffer, std::size_t lo, std::size_t mid, std::size_t hi,
+                  std::size_t parts, const Less& less, ThreadPool& pool)
+{
+  if(parts > mid - lo)
+      parts = mid - lo > 0 ? mid - lo : 1;
+
+  // punkty podzialu liczone przed scalaniem - w trakcie elementy sa juz przenoszone
+  std::vector<std::size_t> leftSplits(parts + 1);
+  std::vector<std::size_t> rightSplits(parts + 1);
+  for(std::size_t part = 0; part <= parts; part++)
+  {
+      leftSplits[part] = lo + (mid - lo) * part / parts;
+      if(part == 0)
+          rightSplits[part] = mid;
+      else if(part == parts)
+          rightSplits[part] = hi;
+      else
+          rightSplits[part] = static_cast<std::size_t>(
+              std::lower_bound(items.begin() + mid, items.begin() + hi, items[leftSplits[part]], less) - items.begin());
+  }
+
+  pool.parallelFor(parts, [&](std::size_t part) {
+      std::merge(std::make_move_iterator(items.begin() + leftSplits[part]),
+                 std::make_move_iterator(items.begin() + leftSplits[part + 1]),
+                 std::make_move_iterator(items.begin() + rightSplits[part]),
+                 std::make_move_iterator(items.begin() + rightSplits[part + 1]),
+                 buffer.begin() + leftSplits[part] + (rightSplits[part] - mid), less);
+  });
+}
+
+}
+
+// stabilne sortowanie w puli: kawalki sortowane niezaleznie, potem scalane parami; kazde
+// scalanie tez dzielone jest na czesci, zeby ostatnie rundy nie zostawaly w jednym watku
+template <typename T, typename Less>
+void parallelStableSort(std::vector<T>& items, Less less, ThreadPool& pool = ThreadPool::instance())
+{
+  static const std::size_t MIN_CHUNK = 4096;
+
+  std::size_t chunks = pool.splitCount();
+  if(chunks > items.size() / MIN_CHUNK)
+      chunks = items.size() / MIN_CHUNK;
+  if(chunks < 2)
+  {
+      std::stable_sort(items.begin(), items.end(), less);
+      return;
+  }
+
+  const std::size_t count = items.size();
+  auto bound = [count, chunks](std::size_t chunk) { return count * (chunk < chunks ? chunk : chunks) / chunks; };
+  pool.parallelFor(chunks, [&](std::size_t chunk) {
+      std::stable_sort(items.begin() + bound(chunk), items.begin() + bound(chunk + 1), less);
+  });
+
+  std::vector<T> buffer(items);
+  for(std::size_t width = 1; width < chunks; width *= 2)
+  {
+      const std::size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+      const std::size_t parts = (pool.splitCount() + pairs - 1) / pairs;
+      pool.parallelFor(pairs, [&](std::size_t pair) {
+          const std::size_t lo = bound(2 * pair * width);
+          const std::size_t mid = bound(2 * pair * width + width);
+          const std::size_t hi = bound(2 * pair * width + 2 * width);
+          if(mid == hi)
+              std::move(items.begin() + lo, items.begin() + hi, buffer.begin() + lo);
+          else
+              detail::mergeInParts(items, buffer, lo, mid, hi, parts, less, pool);
+      });
+      items.swap(buffer);
+  }
+}
+
+}
+
+#endif /* AISDI_MAPS_THREADPOOL_H */
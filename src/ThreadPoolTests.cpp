@@ -0,0 +1,89 @@
+#include <ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTests)
+
+BOOST_AUTO_TEST_CASE(GivenPoolWithoutWorkers_WhenRunningParallelFor_ThenCallerDoesAllWork)
+{
+  aisdi::ThreadPool pool(0);
+  std::vector<int> visited(100, 0);
+
+  pool.parallelFor(visited.size(), [&visited](std::size_t i) { visited[i]++; });
+
+  BOOST_CHECK_EQUAL(pool.getWorkerCount(), 0u);
+  for (int count : visited)
+    BOOST_CHECK_EQUAL(count, 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPoolWithWorkers_WhenRunningParallelFor_ThenEachIndexIsVisitedOnce)
+{
+  aisdi::ThreadPool pool(3);
+  std::vector<std::atomic<int>> visited(1000);
+  for (auto& count : visited)
+    count = 0;
+
+  pool.parallelFor(visited.size(), [&visited](std::size_t i) { visited[i]++; });
+
+  for (const auto& count : visited)
+    BOOST_CHECK_EQUAL(count.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNestedGroups_WhenWaitingInsideTasks_ThenAllTasksFinish)
+{
+  aisdi::ThreadPool pool(2);
+  std::atomic<int> leaves(0);
+
+  pool.parallelFor(8, [&pool, &leaves](std::size_t) {
+    pool.parallelFor(8, [&pool, &leaves](std::size_t) {
+      pool.parallelFor(8, [&leaves](std::size_t) { ++leaves; });
+    });
+  });
+
+  BOOST_CHECK_EQUAL(leaves.load(), 512);
+}
+
+BOOST_AUTO_TEST_CASE(GivenThrowingTask_WhenWaitingForGroup_ThenExceptionIsRethrownAfterOtherTasks)
+{
+  aisdi::ThreadPool pool(2);
+  std::atomic<int> finished(0);
+
+  BOOST_CHECK_THROW(pool.parallelFor(50, [&finished](std::size_t i) {
+                      if (i == 10)
+                        throw std::runtime_error("task failed");
+                      ++finished;
+                    }),
+                    std::runtime_error);
+  BOOST_CHECK_EQUAL(finished.load(), 49);
+}
+
+BOOST_AUTO_TEST_CASE(GivenItemsWithEqualKeys_WhenSortingInParallel_ThenOrderIsStable)
+{
+  aisdi::ThreadPool pool(3);
+  std::vector<std::pair<int, int>> items;
+  std::uint32_t seed = 2024;
+  for (int i = 0; i < 100000; ++i)
+  {
+    seed = seed * 1103515245u + 12345u;
+    items.emplace_back(static_cast<int>((seed >> 8) % 5000), i);
+  }
+  auto expected = items;
+  const auto byKey = [](const std::pair<int, int>& left, const std::pair<int, int>& right) {
+    return left.first < right.first;
+  };
+
+  std::stable_sort(expected.begin(), expected.end(), byKey);
+  aisdi::parallelStableSort(items, byKey, pool);
+
+  BOOST_CHECK(items == expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,11 @@
 #include <stdexcept>
 #include <utility>
 #include <queue>
+#include <memory>
+#include <vector>
+
+#include "PoolAllocator.h"
+#include "ThreadPool.h"
 
 namespace aisdi
 {
@@ -13,7 +18,8 @@ namespace aisdi
 
 
 
-template <typename KeyType, typename ValueType>
+template <typename KeyType, typename ValueType,
+          typename Allocator = PoolAllocator<std::pair<const KeyType, ValueType>>>
 class TreeMap
 {
 public:
@@ -23,6 +29,7 @@ public:
   using size_type = std::size_t;
   using reference = value_type&;
   using const_reference = const value_type&;
+  using allocator_type = Allocator;
 
   class ConstIterator;
   class Iterator;
@@ -38,12 +45,17 @@ private:
         TreeNode* leftchild;
         TreeNode* rightchild;
         TreeNode* parent;
+        bool red;//kolor w drzewie czerwono-czarnym; nowy wezel jest czerwony
+        size_type size;//liczba wezlow w poddrzewie razem z tym
+        TreeNode* next;//nastepnik i poprzednik w kolejnosci kluczy - krok iteratora to jeden skok
+        TreeNode* prev;
         value_type datapair;
 
         TreeNode(key_type key, mapped_type value):
-            leftchild(nullptr), rightchild(nullptr), parent(nullptr), datapair(std::make_pair(key, value)){}
+            leftchild(nullptr), rightchild(nullptr), parent(nullptr), red(true), size(1),
+            next(nullptr), prev(nullptr), datapair(std::make_pair(key, value)){}
         TreeNode():
-             leftchild(nullptr), rightchild(nullptr), parent(nullptr){}
+             leftchild(nullptr), rightchild(nullptr), parent(nullptr), red(true), size(1), next(nullptr), prev(nullptr){}
         TreeNode(value_type it) : TreeNode(it.first,it.second) {}
 
         ~TreeNode()
@@ -51,7 +63,13 @@ private:
         }
 
     };
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<TreeNode>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    NodeAllocator node_alloc;
     TreeNode *root;
+    TreeNode *head;//najmniejszy i najwiekszy klucz
+    TreeNode *tail;
     size_type node_counter;
 
 public:
@@ -63,31 +81,35 @@ public:
   }
 
 
-  TreeMap():root(nullptr), node_counter(0){};
+  TreeMap():root(nullptr), head(nullptr), tail(nullptr), node_counter(0){};
+
+  explicit TreeMap(const Allocator& allocator):node_alloc(allocator), root(nullptr), head(nullptr), tail(nullptr), node_counter(0){};
 
 
 
   TreeMap(std::initializer_list<value_type> list):TreeMap()
   {
     for(auto it = list.begin(); it != list.end(); it++)
-        insert(new TreeNode(*it));
+        insert(createNode(*it));
   }
 
-  TreeMap(const TreeMap& other):TreeMap()
+  // kopia zachowuje ksztalt i kolory drzewa, wiec nie trzeba niczego wstawiac ani rownowazyc
+  TreeMap(const TreeMap& other):node_alloc(NodeTraits::select_on_container_copy_construction(other.node_alloc)),
+      root(nullptr), head(nullptr), tail(nullptr), node_counter(0)
   {
-     for(auto it = other.begin(); it!= other.end(); it++)
-     {
-         insert(new TreeNode(*it));
-     }
-
-
+        cloneFrom(other);
   }
 
-  TreeMap(TreeMap&& other)
+  TreeMap(TreeMap&& other):node_alloc(std::move(other.node_alloc))
   {
+        other.node_alloc = NodeAllocator();
         root=other.root;
+        head=other.head;
+        tail=other.tail;
         node_counter=other.node_counter;
         other.root = nullptr;
+        other.head = nullptr;
+        other.tail = nullptr;
         other.node_counter=0;
 
   }
@@ -97,8 +119,7 @@ public:
         if(this != &other)
             {
               removeTree();
-              for (auto it = other.begin(); it != other.end(); ++it)
-                insert( new TreeNode(*it) );
+              cloneFrom(other);
             }
     return *this;
   }
@@ -109,15 +130,95 @@ public:
             {
               removeTree();
 
+              // wezly przechodza razem z pula, z ktorej je zaalokowano
+              node_alloc = std::move(other.node_alloc);
+              other.node_alloc = NodeAllocator();
               root = other.root;
+              head = other.head;
+              tail = other.tail;
               node_counter = other.node_counter;
 
               other.root = nullptr;
+              other.head = nullptr;
+              other.tail = nullptr;
               other.node_counter = 0;
             }
         return *this;
   }
 
+private:
+
+  // mapy tworzone przez split i operacje na zbiorach dziela pule z mapa zrodlowa
+  explicit TreeMap(const NodeAllocator& allocator):node_alloc(allocator), root(nullptr), head(nullptr), tail(nullptr), node_counter(0){};
+
+  TreeMap(const TreeMap& other, const NodeAllocator& allocator):node_alloc(allocator),
+      root(nullptr), head(nullptr), tail(nullptr), node_counter(0)
+  {
+        cloneFrom(other);
+  }
+
+public:
+
+  // buduje zrownowazone drzewo w O(n) z par posortowanych rosnaco wedlug klucza;
+  // przy powtorzonym kluczu zostaje ostatnia wartosc
+  template <typename InputIt>
+  static TreeMap fromSorted(InputIt first, InputIt last, const Allocator& allocator = Allocator())
+  {
+        TreeMap result(allocator);
+        std::vector<TreeNode*> nodes;
+        try
+        {
+            for(; first != last; ++first)
+            {
+                const value_type& item = *first;
+                if(!nodes.empty() && !(nodes.back()->datapair.first < item.first))
+                {
+                    if(item.first < nodes.back()->datapair.first)
+                        throw std::invalid_argument("fromSorted: input is not sorted");
+                    nodes.back()->datapair.second = item.second;
+                    continue;
+                }
+                nodes.reserve(nodes.size() + 1);
+                nodes.push_back(result.createNode(item));
+            }
+        }
+        catch(...)
+        {
+            for(TreeNode* node : nodes)
+                result.destroyNode(node);
+            throw;
+        }
+        result.rebuild(nodes);
+        return result;
+  }
+
+  // buduje mape z par w dowolnej kolejnosci: sortowanie w puli watkow, usuniecie powtorzen
+  // (zostaje ostatnia wartosc, jak przy kolejnych operator[]) i zrownowazone drzewo skladane
+  // od dolu. Wezly dostaja kolejne bloki nowej puli, wiec leza w pamieci w kolejnosci kluczy.
+  template <typename InputIt>
+  static TreeMap fromUnsorted(InputIt first, InputIt last, ThreadPool& pool = ThreadPool::instance(),
+                              const Allocator& allocator = Allocator())
+  {
+        std::vector<std::pair<key_type, mapped_type>> items(first, last);
+        parallelStableSort(items, [](const std::pair<key_type, mapped_type>& left, const std::pair<key_type, mapped_type>& right) {
+            return left.first < right.first;
+        }, pool);
+
+        size_type kept = 0;
+        for(size_type i = 0; i < items.size(); i++)
+        {
+            if(kept > 0 && !(items[kept - 1].first < items[i].first))
+                items[kept - 1].second = std::move(items[i].second);
+            else if(kept++ != i)
+                items[kept - 1] = std::move(items[i]);
+        }
+        items.erase(items.begin() + kept, items.end());
+
+        TreeMap result(allocator);
+        result.buildFromSorted(items, pool);
+        return result;
+  }
+
   bool isEmpty() const
   {
         return (node_counter == 0);
@@ -130,7 +231,7 @@ public:
         TreeNode* current = findNode(key);
         if( current == nullptr)
         {
-            current = new TreeNode(key,mapped_type());
+            current = createNode(value_type(key,mapped_type()));
             insert( current);
         }
         return current->datapair.second;
@@ -159,6 +260,35 @@ public:
         return iterator(this,findNode(key));
   }
 
+  // szuka zaczynajac od hint: klucz hint i jego sasiadow sprawdza w O(1), dalej wspina sie
+  // od hint tylko do przodka, ktorego poddrzewo obejmuje key, i stamtad schodzi
+  const_iterator find(const const_iterator& hint, const key_type& key) const
+  {
+        TreeNode* parent;
+        return const_iterator(this, fingerNode(checkedHint(hint), key, parent));
+  }
+
+  iterator find(const const_iterator& hint, const key_type& key)
+  {
+        TreeNode* parent;
+        return iterator(this, fingerNode(checkedHint(hint), key, parent));
+  }
+
+  // wstawia pare, jesli klucza nie ma (istniejaca wartosc zostaje), i zwraca iterator do niej.
+  // Gdy key lezy tuz przed hint albo tuz za nim, wezel doczepiany jest bez porownan z reszta
+  // drzewa, wiec dopisywanie rosnacych kluczy z hint == end() nie schodzi od korzenia
+  iterator insert(const const_iterator& hint, const key_type& key, const mapped_type& mapped)
+  {
+        TreeNode* parent;
+        TreeNode* found = fingerNode(checkedHint(hint), key, parent);
+        if(found != nullptr)
+            return iterator(this, found);
+
+        TreeNode* node = createNode(value_type(key, mapped));
+        attachNode(parent, node);
+        return iterator(this, node);
+  }
+
   void remove(const key_type& key)
   {
         remove(find(key));
@@ -169,37 +299,448 @@ public:
     if(it == end())
         throw std::out_of_range("error: out of range");
 
-    if(it.curr_node->leftchild == nullptr)
-        transplant(it.curr_node,it.curr_node->rightchild);
+    removeNode(it.curr_node);
+  }
+
+  const_iterator lowerBound(const key_type& key) const
+  {
+        return const_iterator(this, lowerBoundNode(key));
+  }
+
+  iterator lowerBound(const key_type& key)
+  {
+        return iterator(this, lowerBoundNode(key));
+  }
+
+  const_iterator upperBound(const key_type& key) const
+  {
+        return const_iterator(this, upperBoundNode(key));
+  }
+
+  iterator upperBound(const key_type& key)
+  {
+        return iterator(this, upperBoundNode(key));
+  }
+
+  std::pair<const_iterator, const_iterator> equalRange(const key_type& key) const
+  {
+        TreeNode* first = equalRangeNode(key);
+        TreeNode* last = (first != nullptr && !(key < first->datapair.first)) ? first->next : first;
+        return std::make_pair(const_iterator(this, first), const_iterator(this, last));
+  }
+
+  std::pair<iterator, iterator> equalRange(const key_type& key)
+  {
+        TreeNode* first = equalRangeNode(key);
+        TreeNode* last = (first != nullptr && !(key < first->datapair.first)) ? first->next : first;
+        return std::make_pair(iterator(this, first), iterator(this, last));
+  }
+
+  // usuwa klucze z przedzialu [lo, hi). Przy malym przedziale wezly odpinane sa po kolei
+  // (bez ponownego schodzenia od korzenia), przy duzym drzewo budowane jest od nowa
+  // z pozostalych wezlow, co kosztuje O(n) zamiast O(k log n).
+  void removeRange(const key_type& lo, const key_type& hi)
+  {
+    if(!(lo < hi))
+        return;
+
+    const size_type count = countInRange(lo, hi);
+    if(count == 0)
+        return;
+
+    if(preferSingleSteps(count, node_counter))
+    {
+        TreeNode* temp = lowerBoundNode(lo);
+        for(size_type i = 0; i < count; i++)
+        {
+            TreeNode* next = temp->next;
+            removeNode(temp);
+            temp = next;
+        }
+        return;
+    }
+
+    std::vector<TreeNode*> kept;
+    kept.reserve(node_counter - count);
+    std::vector<TreeNode*> removed;
+    removed.reserve(count);
+    for(TreeNode* temp = head; temp != nullptr; temp = temp->next)
+    {
+        if(temp->datapair.first < lo || !(temp->datapair.first < hi))
+            kept.push_back(temp);
+        else
+            removed.push_back(temp);
+    }
+    for(TreeNode* node : removed)
+        destroyNode(node);
+
+    rebuild(kept);
+  }
+
+  // przenosi klucze >= key do zwracanej mapy, w tej zostaja mniejsze. Drzewo rozcinane jest
+  // wzdluz sciezki do key i sklejane operacjami join, wiec koszt to O(log^2 n), a wezly
+  // nie sa kopiowane - obie mapy dziela pule alokatora
+  TreeMap split(const key_type& key)
+  {
+    TreeMap result(node_alloc);
+    TreeNode* first = lowerBoundNode(key);
+    if(first == nullptr)
+        return result;
+
+    const std::pair<TreeNode*, TreeNode*> parts = splitTree(root, key);
+    root = parts.first;
+    result.root = parts.second;
+    node_counter = sizeOf(root);
+    result.node_counter = sizeOf(result.root);
+
+    result.head = first;
+    result.tail = tail;
+    tail = first->prev;
+    if(tail != nullptr)
+        tail->next = nullptr;
+    else
+        head = nullptr;
+    first->prev = nullptr;
+    return result;
+  }
+
+  // skleja mapy, w ktorych kazdy klucz left jest mniejszy od kazdego klucza right, w O(log n).
+  // Wezly right sa przepinane, jesli mapy dziela alokator (np. po split), inaczej kopiowane.
+  static TreeMap join(TreeMap&& left, TreeMap&& right)
+  {
+    TreeMap result(std::move(left));
+    result.append(std::move(right));
+    return result;
+  }
+
+  // dodaje klucze other, ktorych brak w tej mapie; przy powtorzonym kluczu zostaje wartosc
+  // z tej mapy. Gdy other jest duzo mniejsza (lub wieksza), wezly wstawiane sa po jednym,
+  // w pozostalych przypadkach obie listy scalane sa liniowo i drzewo budowane od nowa.
+  void unionWith(TreeMap&& other)
+  {
+    if(&other == this || other.isEmpty())
+        return;
+    if(isEmpty())
+    {
+        *this = std::move(other);
+        return;
+    }
+    if(node_alloc != other.node_alloc)
+    {
+        TreeMap adopted(other, node_alloc);
+        other.removeTree();
+        unionWith(std::move(adopted));
+        return;
+    }
+    if(other.tail->datapair.first < head->datapair.first)
+    {
+        other.append(std::move(*this));
+        *this = std::move(other);
+        return;
+    }
+    if(tail->datapair.first < other.head->datapair.first)
+    {
+        append(std::move(other));
+        return;
+    }
+
+    if(preferSingleSteps(other.node_counter, node_counter))
+    {
+        insertNodesFrom(other, false);
+        return;
+    }
+    if(preferSingleSteps(node_counter, other.node_counter))
+    {
+        other.insertNodesFrom(*this, true);
+        *this = std::move(other);
+        return;
+    }
+
+    std::vector<TreeNode*> nodes;
+    nodes.reserve(node_counter + other.node_counter);
+    TreeNode* ours = head;
+    TreeNode* theirs = other.head;
+    other.forgetNodes();
+    while(ours != nullptr && theirs != nullptr)
+    {
+        if(theirs->datapair.first < ours->datapair.first)
+        {
+            nodes.push_back(theirs);
+            theirs = theirs->next;
+            continue;
+        }
+        if(!(ours->datapair.first < theirs->datapair.first))
+        {
+            TreeNode* next = theirs->next;
+            destroyNode(theirs);
+            theirs = next;
+        }
+        nodes.push_back(ours);
+        ours = ours->next;
+    }
+    for(; ours != nullptr; ours = ours->next)
+        nodes.push_back(ours);
+    for(; theirs != nullptr; theirs = theirs->next)
+        nodes.push_back(theirs);
+    rebuild(nodes);
+  }
+
+  void unionWith(const TreeMap& other)
+  {
+    if(&other != this)
+        unionWith(TreeMap(other, node_alloc));
+  }
+
+  // zostawia tylko klucze obecne takze w other
+  void intersectWith(const TreeMap& other)
+  {
+    if(&other == this)
+        return;
+
+    std::vector<TreeNode*> kept;
+    kept.reserve(node_counter < other.node_counter ? node_counter : other.node_counter);
+    std::vector<TreeNode*> removed;
+    removed.reserve(node_counter);
+    collectMatching(other, kept, removed);
+    if(removed.empty())
+        return;
+
+    for(TreeNode* node : removed)
+        destroyNode(node);
+    rebuild(kept);
+  }
+
+  // usuwa klucze obecne w other
+  void differenceWith(const TreeMap& other)
+  {
+    if(&other == this)
+    {
+        removeTree();
+        return;
+    }
+
+    if(preferSingleSteps(other.node_counter, node_counter))
+    {
+        for(TreeNode* temp = other.head; temp != nullptr; temp = temp->next)
+        {
+            TreeNode* found = findNode(temp->datapair.first);
+            if(found != nullptr)
+                removeNode(found);
+        }
+        return;
+    }
+
+    std::vector<TreeNode*> kept;
+    kept.reserve(node_counter);
+    std::vector<TreeNode*> removed;
+    removed.reserve(node_counter < other.node_counter ? node_counter : other.node_counter);
+    collectMatching(other, removed, kept);
+    if(removed.empty())
+        return;
+
+    for(TreeNode* node : removed)
+        destroyNode(node);
+    rebuild(kept);
+  }
+
+private:
 
-    else if(it.curr_node->rightchild == nullptr)
-        transplant(it.curr_node,it.curr_node->leftchild);
+  void removeNode(TreeNode* outNode)
+  {
+    detachNode(outNode);
+    destroyNode(outNode);
+  }
+
+  // odpina wezel od drzewa i listy, ale go nie zwalnia
+  void detachNode(TreeNode* outNode)
+  {
+    TreeNode* fixNode;//wezel, ktory zajal miejsce usunietego czarnego wezla (moze byc nullptr)
+    TreeNode* fixParent;
+    bool removedRed = outNode->red;
 
+    unlinkNode(outNode);
+
+    if(outNode->leftchild == nullptr || outNode->rightchild == nullptr)
+        shrinkPath(outNode->parent);
+
+    if(outNode->leftchild == nullptr)
+    {
+        fixNode = outNode->rightchild;
+        fixParent = outNode->parent;
+        transplant(outNode, outNode->rightchild);
+    }
+    else if(outNode->rightchild == nullptr)
+    {
+        fixNode = outNode->leftchild;
+        fixParent = outNode->parent;
+        transplant(outNode, outNode->leftchild);
+    }
     else
         {
-            TreeNode* temp = findMin(it.curr_node->rightchild);
+            TreeNode* temp = findMin(outNode->rightchild);
+            removedRed = temp->red;
+            fixNode = temp->rightchild;
+            shrinkPath(temp->parent);//nastepnik znika ze swojego miejsca, sciezka obejmuje outNode
 
-            if (temp->parent != it.curr_node)
+            if (temp->parent != outNode)
             {
+                fixParent = temp->parent;
                 transplant(temp, temp->rightchild);
-                temp->rightchild = it.curr_node->rightchild;
+                temp->rightchild = outNode->rightchild;
                 temp->rightchild->parent = temp;
-
             }
-            transplant(it.curr_node, temp);
-            temp->leftchild = it.curr_node->leftchild;
+            else
+                fixParent = temp;
+
+            transplant(outNode, temp);
+            temp->leftchild = outNode->leftchild;
             temp->leftchild->parent = temp;
+            temp->red = outNode->red;
+            temp->size = outNode->size;
         }
-        delete it.curr_node;
+
+        if(!removedRed)
+            removeFixup(fixNode, fixParent);
+
         node_counter--;
   }
 
+public:
+
   size_type getSize() const
   {
     return node_counter;
   }
 
+  // liczba kluczy mniejszych od key
+  size_type rank(const key_type& key) const
+  {
+    size_type result = 0;
+    for(TreeNode* temp = root; temp != nullptr;)
+    {
+        if(temp->datapair.first < key)
+        {
+            result += sizeOf(temp->leftchild) + 1;
+            temp = temp->rightchild;
+        }
+        else
+            temp = temp->leftchild;
+    }
+    return result;
+  }
+
+  // k-ty najmniejszy klucz (liczac od zera) albo end(), gdy k >= getSize()
+  const_iterator select(size_type k) const
+  {
+    return const_iterator(this, selectNode(k));
+  }
+
+  iterator select(size_type k)
+  {
+    return iterator(this, selectNode(k));
+  }
+
+  // liczba kluczy z przedzialu [lo, hi)
+  size_type countInRange(const key_type& lo, const key_type& hi) const
+  {
+    if(!(lo < hi))
+        return 0;
+    return rank(hi) - rank(lo);
+  }
+
+  // liczba poziomow drzewa; dla drzewa czerwono-czarnego nie wiecej niz 2*log2(n+1)
+  size_type height() const
+  {
+    return subtreeHeight(root);
+  }
+
+
+
+  // wywoluje fn(para) dla kazdego elementu w watkach puli; zadanie dostaje poddrzewo (przedzial
+  // kolejnych kluczy) i idzie po nim dowiazaniami next. Kolejnosc miedzy zadaniami jest dowolna.
+  template <typename Function>
+  void parallelForEach(Function fn, ThreadPool& pool = ThreadPool::instance())
+  {
+    forEachInRanges(pool, [&fn](TreeNode* node, size_type) { fn(node->datapair); });
+  }
+
+  template <typename Function>
+  void parallelForEach(Function fn, ThreadPool& pool = ThreadPool::instance()) const
+  {
+    forEachInRanges(pool, [&fn](const TreeNode* node, size_type) { fn(static_cast<const value_type&>(node->datapair)); });
+  }
+
+  // combine(init, map(para), map(para), ...) po wszystkich elementach, jak std::accumulate;
+  // wyniki przedzialow sa laczone w kolejnosci kluczy, wiec combine musi byc tylko laczne
+  template <typename T, typename MapFunction, typename Combine>
+  T parallelReduce(T init, MapFunction map, Combine combine, ThreadPool& pool = ThreadPool::instance()) const
+  {
+    std::vector<NodeRange> ranges;
+    collectRanges(root, rangeSize(pool), ranges);
+    std::vector<detail::PartialResult<T>> partial(ranges.size(), detail::PartialResult<T>(init));
+    pool.parallelFor(ranges.size(), [&](size_type range) {
+        TreeNode* node = ranges[range].first;
+        for(size_type i = 0; i < ranges[range].count; i++, node = node->next)
+            partial[range].add(map(static_cast<const value_type&>(node->datapair)), combine);
+    });
+
+    for(auto& item : partial)
+        if(item.filled)
+            init = combine(std::move(init), std::move(item.value));
+    return init;
+  }
+
+private:
+
+  // przedzial kolejnych wezlow: pierwszy i ich liczba
+  struct NodeRange
+  {
+    TreeNode* first;
+    size_type count;
+  };
+
+  size_type rangeSize(const ThreadPool& pool) const
+  {
+    const size_type size = node_counter / pool.splitCount();
+    return size > 0 ? size : 1;
+  }
+
+  // poddrzewa nie wieksze niz limit to gotowe przedzialy; wezel z wiekszego poddrzewa dopisujemy
+  // do przedzialu jego lewego sasiada, bo przedzialy powstaja w kolejnosci kluczy
+  void collectRanges(TreeNode* node, size_type limit, std::vector<NodeRange>& ranges) const
+  {
+    if(node == nullptr)
+        return;
+    if(node->size <= limit)
+    {
+        TreeNode* first = node;
+        while(first->leftchild != nullptr)
+            first = first->leftchild;
+        ranges.push_back(NodeRange{first, node->size});
+        return;
+    }
+
+    collectRanges(node->leftchild, limit, ranges);
+    if(ranges.empty())
+        ranges.push_back(NodeRange{node, 1});
+    else
+        ranges.back().count++;
+    collectRanges(node->rightchild, limit, ranges);
+  }
+
+  template <typename Function>
+  void forEachInRanges(ThreadPool& pool, const Function& fn) const
+  {
+    std::vector<NodeRange> ranges;
+    collectRanges(root, rangeSize(pool), ranges);
+    pool.parallelFor(ranges.size(), [&ranges, &fn](size_type range) {
+        TreeNode* node = ranges[range].first;
+        for(size_type i = 0; i < ranges[range].count; i++, node = node->next)
+            fn(node, range);
+    });
+  }
 
+public:
 
   bool operator==(const TreeMap& other) const
   {
@@ -221,7 +762,7 @@ public:
 
   iterator begin()
   {
-        return Iterator(this, findMin(root));
+        return Iterator(this, head);
   }
 
   iterator end()
@@ -231,7 +772,7 @@ public:
 
   const_iterator cbegin() const
   {
-        return ConstIterator(this, findMin(root));
+        return ConstIterator(this, head);
   }
 
   const_iterator cend() const
@@ -250,10 +791,11 @@ public:
   }
 
 
+private:
 
 void transplant(TreeNode* outNode, TreeNode* inNode)
 {
-    if(outNode->rightchild == nullptr)
+    if(outNode->parent == nullptr)
         root = inNode;
     else if(outNode->parent->leftchild == outNode)
         outNode->parent->leftchild = inNode;
@@ -261,36 +803,657 @@ void transplant(TreeNode* outNode, TreeNode* inNode)
         outNode->parent->rightchild = inNode;
 
     if(inNode != nullptr)
-        inNode->rightchild = outNode->rightchild;
+        inNode->parent = outNode->parent;
 
 }
 
+void linkBefore(TreeNode* position, TreeNode* node)
+{
+    node->next = position;
+    node->prev = position->prev;
+    if(position->prev != nullptr)
+        position->prev->next = node;
+    else
+        head = node;
+    position->prev = node;
+}
 
-TreeNode* findNode(const key_type& key) const
+void linkAfter(TreeNode* position, TreeNode* node)
 {
+    node->prev = position;
+    node->next = position->next;
+    if(position->next != nullptr)
+        position->next->prev = node;
+    else
+        tail = node;
+    position->next = node;
+}
 
-    TreeNode* temp = root;
-        while(temp != nullptr && temp->datapair.first != key)
-        {
-            if(key > temp->datapair.first)
-                temp = temp -> rightchild;
+void unlinkNode(TreeNode* node)
+{
+    if(node->prev != nullptr)
+        node->prev->next = node->next;
+    else
+        head = node->next;
+    if(node->next != nullptr)
+        node->next->prev = node->prev;
+    else
+        tail = node->prev;
+}
 
-            else
-                temp = temp -> leftchild;
+// pierwszy wezel z kluczem >= key
+TreeNode* lowerBoundNode(const key_type& key) const
+{
+    TreeNode* result = nullptr;
+    for(TreeNode* temp = root; temp != nullptr;)
+    {
+        if(temp->datapair.first < key)
+            temp = temp->rightchild;
+        else
+        {
+            result = temp;
+            temp = temp->leftchild;
         }
-
-    return temp;
-
+    }
+    return result;
 }
 
-TreeNode* findMax(TreeNode* temp) const
+// pierwszy wezel z kluczem > key
+TreeNode* upperBoundNode(const key_type& key) const
+{
+    TreeNode* result = nullptr;
+    for(TreeNode* temp = root; temp != nullptr;)
     {
-        if(root == nullptr)
-            return nullptr;
-
-        while(temp->rightchild != nullptr)
+        if(key < temp->datapair.first)
+        {
+            result = temp;
+            temp = temp->leftchild;
+        }
+        else
             temp = temp->rightchild;
-        return temp;
+    }
+    return result;
+}
+
+// jak lowerBoundNode, ale konczy zejscie na wezle z rownym kluczem
+TreeNode* equalRangeNode(const key_type& key) const
+{
+    TreeNode* result = nullptr;
+    for(TreeNode* temp = root; temp != nullptr;)
+    {
+        if(temp->datapair.first < key)
+            temp = temp->rightchild;
+        else if(key < temp->datapair.first)
+        {
+            result = temp;
+            temp = temp->leftchild;
+        }
+        else
+            return temp;
+    }
+    return result;
+}
+
+// uklada posortowane wezly w drzewo o wysokosci ceil(log2(n+1)); czerwone sa tylko wezly
+// niepelnego ostatniego poziomu, wiec kazda sciezka ma tyle samo czarnych wezlow
+TreeNode* buildBalanced(TreeNode* const* nodes, size_type count, size_type level, size_type redLevel, TreeNode* parent)
+{
+    if(count == 0)
+        return nullptr;
+    const size_type middle = count / 2;
+    TreeNode* node = nodes[middle];
+    node->parent = parent;
+    node->red = (level == redLevel);
+    node->size = count;
+    node->leftchild = buildBalanced(nodes, middle, level + 1, redLevel, node);
+    node->rightchild = buildBalanced(nodes + middle + 1, count - middle - 1, level + 1, redLevel, node);
+    return node;
+}
+
+static const size_type PARALLEL_BUILD_GRAIN = 16384;
+
+// jak buildBalanced, ale lewe poddrzewa duzych poddrzew powstaja w innym watku puli
+TreeNode* buildBalanced(TreeNode* const* nodes, size_type count, size_type level, size_type redLevel, TreeNode* parent,
+                        ThreadPool& pool)
+{
+    if(count <= PARALLEL_BUILD_GRAIN)
+        return buildBalanced(nodes, count, level, redLevel, parent);
+    const size_type middle = count / 2;
+    TreeNode* node = nodes[middle];
+    node->parent = parent;
+    node->red = (level == redLevel);
+    node->size = count;
+
+    ThreadPool::TaskGroup group(pool);
+    bool spawned = true;
+    try
+    {
+        group.run([this, node, nodes, middle, level, redLevel, &pool]() {
+            node->leftchild = buildBalanced(nodes, middle, level + 1, redLevel, node, pool);
+        });
+    }
+    catch(...)
+    {
+        spawned = false;//zadanie nie weszlo do puli - lewe poddrzewo budujemy tutaj
+    }
+    node->rightchild = buildBalanced(nodes + middle + 1, count - middle - 1, level + 1, redLevel, node, pool);
+    if(!spawned)
+        node->leftchild = buildBalanced(nodes, middle, level + 1, redLevel, node, pool);
+    group.wait();
+    return node;
+}
+
+// pusta mapa z posortowanych par bez powtorzen, ktore przenosi do wezlow. Bloki z puli przydzielane
+// sa po kolei (pula nie jest bezpieczna watkowo), a przenoszenie par i skladanie drzewa - rownolegle.
+void buildFromSorted(std::vector<std::pair<key_type, mapped_type>>& items, ThreadPool& pool)
+{
+    std::vector<TreeNode*> nodes;
+    nodes.reserve(items.size());
+    try
+    {
+        for(size_type i = 0; i < items.size(); i++)
+            nodes.push_back(NodeTraits::allocate(node_alloc, 1));
+    }
+    catch(...)
+    {
+        for(TreeNode* node : nodes)
+            NodeTraits::deallocate(node_alloc, node, 1);
+        throw;
+    }
+
+    const size_type ranges = pool.splitCount() < nodes.size() ? pool.splitCount() : (nodes.empty() ? 1 : nodes.size());
+    auto bound = [&nodes, ranges](size_type range) { return nodes.size() * range / ranges; };
+    std::vector<size_type> built(ranges, 0);
+    try
+    {
+        pool.parallelFor(ranges, [&](size_type range) {
+            size_type i = bound(range);
+            try
+            {
+                for(; i < bound(range + 1); i++)
+                    NodeTraits::construct(node_alloc, nodes[i], std::move(items[i].first), std::move(items[i].second));
+            }
+            catch(...)
+            {
+                built[range] = i - bound(range);
+                throw;
+            }
+            built[range] = i - bound(range);
+        });
+    }
+    catch(...)
+    {
+        for(size_type range = 0; range < ranges; range++)
+            for(size_type i = bound(range); i < bound(range) + built[range]; i++)
+                NodeTraits::destroy(node_alloc, nodes[i]);
+        for(TreeNode* node : nodes)
+            NodeTraits::deallocate(node_alloc, node, 1);
+        throw;
+    }
+
+    size_type fullLevels = 0;
+    while((size_type(2) << fullLevels) - 1 <= nodes.size())
+        fullLevels++;
+    root = buildBalanced(nodes.data(), nodes.size(), 0, fullLevels, nullptr, pool);
+    node_counter = nodes.size();
+
+    head = nodes.empty() ? nullptr : nodes.front();
+    tail = nodes.empty() ? nullptr : nodes.back();
+    pool.parallelFor(ranges, [&](size_type range) {
+        for(size_type i = bound(range); i < bound(range + 1); i++)
+        {
+            nodes[i]->prev = i > 0 ? nodes[i - 1] : nullptr;
+            nodes[i]->next = i + 1 < nodes.size() ? nodes[i + 1] : nullptr;
+        }
+    });
+}
+
+void rebuild(const std::vector<TreeNode*>& nodes)
+{
+    size_type fullLevels = 0;
+    while((size_type(2) << fullLevels) - 1 <= nodes.size())
+        fullLevels++;
+    root = buildBalanced(nodes.data(), nodes.size(), 0, fullLevels, nullptr);
+    node_counter = nodes.size();
+
+    head = nodes.empty() ? nullptr : nodes.front();
+    tail = nodes.empty() ? nullptr : nodes.back();
+    for(size_type i = 0; i < nodes.size(); i++)
+    {
+        nodes[i]->prev = i > 0 ? nodes[i - 1] : nullptr;
+        nodes[i]->next = i + 1 < nodes.size() ? nodes[i + 1] : nullptr;
+    }
+}
+
+// pojedyncze operacje O(log n) oplacaja sie, gdy count*log(total) < total; inaczej O(n) przebudowa
+static bool preferSingleSteps(size_type count, size_type total)
+{
+    size_type logSize = 1;
+    for(size_type n = total; n > 1; n /= 2)
+        logSize++;
+    return count * logSize < total;
+}
+
+// liczba czarnych wezlow na sciezce od node do liscia
+static size_type blackHeight(const TreeNode* node)
+{
+    size_type result = 0;
+    for(; node != nullptr; node = node->leftchild)
+        if(!node->red)
+            result++;
+    return result;
+}
+
+// laczy drzewa o kluczach left < middle < right (korzenie bez rodzicow) w jedno drzewo.
+// middle schodzi po brzegu wyzszego drzewa do poddrzewa o czarnej wysokosci nizszego,
+// wiec koszt to roznica wysokosci. Rotacje przepinaja root, dlatego sluzy on tu za brudnopis.
+TreeNode* joinTrees(TreeNode* left, TreeNode* middle, TreeNode* right)
+{
+    if(left != nullptr)
+        left->red = false;
+    if(right != nullptr)
+        right->red = false;
+    const size_type leftHeight = blackHeight(left);
+    const size_type rightHeight = blackHeight(right);
+
+    TreeNode* parent = nullptr;
+    if(leftHeight >= rightHeight)
+    {
+        root = left;
+        size_type height = leftHeight;
+        while(height > rightHeight || isRed(left))
+        {
+            if(!left->red)
+                height--;
+            left->size += sizeOf(right) + 1;
+            parent = left;
+            left = left->rightchild;
+        }
+        if(parent == nullptr)
+            root = middle;
+        else
+            parent->rightchild = middle;
+    }
+    else
+    {
+        root = right;
+        size_type height = rightHeight;
+        while(height > leftHeight || isRed(right))
+        {
+            if(!right->red)
+                height--;
+            right->size += sizeOf(left) + 1;
+            parent = right;
+            right = right->leftchild;
+        }
+        parent->leftchild = middle;
+    }
+
+    middle->parent = parent;
+    middle->leftchild = left;
+    middle->rightchild = right;
+    if(left != nullptr)
+        left->parent = middle;
+    if(right != nullptr)
+        right->parent = middle;
+    middle->red = true;
+    middle->size = sizeOf(left) + sizeOf(right) + 1;
+    insertFixup(middle);
+    return root;
+}
+
+// rozcina poddrzewo na klucze < key i >= key; obie czesci wracaja jako osobne drzewa
+std::pair<TreeNode*, TreeNode*> splitTree(TreeNode* node, const key_type& key)
+{
+    if(node == nullptr)
+        return std::pair<TreeNode*, TreeNode*>(nullptr, nullptr);
+
+    TreeNode* left = node->leftchild;
+    TreeNode* right = node->rightchild;
+    if(left != nullptr)
+        left->parent = nullptr;
+    if(right != nullptr)
+        right->parent = nullptr;
+
+    if(node->datapair.first < key)
+    {
+        const std::pair<TreeNode*, TreeNode*> parts = splitTree(right, key);
+        return std::make_pair(joinTrees(left, node, parts.first), parts.second);
+    }
+    const std::pair<TreeNode*, TreeNode*> parts = splitTree(left, key);
+    return std::make_pair(parts.first, joinTrees(parts.second, node, right));
+}
+
+// dokleja other, ktorej klucze sa wieksze od wszystkich kluczy tej mapy; jej najmniejszy
+// wezel staje sie laczacym korzeniem
+void append(TreeMap&& other)
+{
+    if(other.isEmpty())
+        return;
+    if(isEmpty())
+    {
+        *this = std::move(other);
+        return;
+    }
+    if(!(tail->datapair.first < other.head->datapair.first))
+        throw std::invalid_argument("join: keys of maps overlap");
+    if(node_alloc != other.node_alloc)
+    {
+        TreeMap adopted(other, node_alloc);
+        other.removeTree();
+        append(std::move(adopted));
+        return;
+    }
+
+    TreeNode* middle = other.head;
+    other.detachNode(middle);
+    const size_type total = node_counter + other.node_counter + 1;
+    TreeNode* otherRoot = other.root;
+    TreeNode* otherHead = other.head;
+    TreeNode* otherTail = other.tail;
+    other.forgetNodes();
+
+    root = joinTrees(root, middle, otherRoot);
+    node_counter = total;
+    linkAfter(tail, middle);
+    if(otherHead != nullptr)
+    {
+        middle->next = otherHead;
+        otherHead->prev = middle;
+        tail = otherTail;
+    }
+}
+
+// przepina wezly other pojedynczymi wstawieniami; przy powtorzonym kluczu wartosc z other
+// nadpisuje obecna tylko, gdy overwrite
+void insertNodesFrom(TreeMap& other, bool overwrite)
+{
+    TreeNode* temp = other.head;
+    other.forgetNodes();
+    while(temp != nullptr)
+    {
+        TreeNode* next = temp->next;
+        TreeNode* existing = findNode(temp->datapair.first);
+        if(existing == nullptr)
+        {
+            resetNode(temp);
+            insert(temp);
+        }
+        else
+        {
+            if(overwrite)
+                existing->datapair.second = std::move(temp->datapair.second);
+            destroyNode(temp);
+        }
+        temp = next;
+    }
+}
+
+// dzieli wezly tej mapy na te, ktorych klucze sa w other, i pozostale (obie listy rosnaco)
+void collectMatching(const TreeMap& other, std::vector<TreeNode*>& matching, std::vector<TreeNode*>& rest) const
+{
+    if(preferSingleSteps(node_counter, other.node_counter))
+    {
+        for(TreeNode* temp = head; temp != nullptr; temp = temp->next)
+            (other.findNode(temp->datapair.first) != nullptr ? matching : rest).push_back(temp);
+        return;
+    }
+
+    const TreeNode* theirs = other.head;
+    for(TreeNode* temp = head; temp != nullptr; temp = temp->next)
+    {
+        while(theirs != nullptr && theirs->datapair.first < temp->datapair.first)
+            theirs = theirs->next;
+        if(theirs != nullptr && !(temp->datapair.first < theirs->datapair.first))
+            matching.push_back(temp);
+        else
+            rest.push_back(temp);
+    }
+}
+
+// wezly przeszly do innego drzewa albo zostaly zwolnione
+void forgetNodes()
+{
+    root = nullptr;
+    head = nullptr;
+    tail = nullptr;
+    node_counter = 0;
+}
+
+// przygotowuje odpiety wezel do ponownego wstawienia
+static void resetNode(TreeNode* node)
+{
+    node->leftchild = nullptr;
+    node->rightchild = nullptr;
+    node->parent = nullptr;
+    node->red = true;
+    node->size = 1;
+    node->next = nullptr;
+    node->prev = nullptr;
+}
+
+static size_type sizeOf(const TreeNode* node)
+{
+    return node == nullptr ? 0 : node->size;
+}
+
+// po odlaczeniu wezla poddrzewa wszystkich jego przodkow maja o jeden wezel mniej
+static void shrinkPath(TreeNode* node)
+{
+    for(; node != nullptr; node = node->parent)
+        node->size--;
+}
+
+TreeNode* selectNode(size_type k) const
+{
+    if(k >= node_counter)
+        return nullptr;
+    TreeNode* temp = root;
+    while(true)
+    {
+        const size_type leftSize = sizeOf(temp->leftchild);
+        if(k == leftSize)
+            return temp;
+        if(k < leftSize)
+            temp = temp->leftchild;
+        else
+        {
+            k -= leftSize + 1;
+            temp = temp->rightchild;
+        }
+    }
+}
+
+static size_type subtreeHeight(const TreeNode* node)
+{
+    if(node == nullptr)
+        return 0;
+    const size_type left = subtreeHeight(node->leftchild);
+    const size_type right = subtreeHeight(node->rightchild);
+    return 1 + (left > right ? left : right);
+}
+
+static bool isRed(const TreeNode* node)
+{
+    return node != nullptr && node->red;
+}
+
+void rotateLeft(TreeNode* node)
+{
+    TreeNode* pivot = node->rightchild;
+    node->rightchild = pivot->leftchild;
+    if(pivot->leftchild != nullptr)
+        pivot->leftchild->parent = node;
+    transplant(node, pivot);
+    pivot->leftchild = node;
+    node->parent = pivot;
+    pivot->size = node->size;
+    node->size = sizeOf(node->leftchild) + sizeOf(node->rightchild) + 1;
+}
+
+void rotateRight(TreeNode* node)
+{
+    TreeNode* pivot = node->leftchild;
+    node->leftchild = pivot->rightchild;
+    if(pivot->rightchild != nullptr)
+        pivot->rightchild->parent = node;
+    transplant(node, pivot);
+    pivot->rightchild = node;
+    node->parent = pivot;
+    pivot->size = node->size;
+    node->size = sizeOf(node->leftchild) + sizeOf(node->rightchild) + 1;
+}
+
+// przywraca wlasnosci drzewa czerwono-czarnego po dolaczeniu czerwonego liscia
+void insertFixup(TreeNode* node)
+{
+    while(isRed(node->parent))
+    {
+        TreeNode* parent = node->parent;
+        TreeNode* grandparent = parent->parent;
+
+        if(parent == grandparent->leftchild)
+        {
+            TreeNode* uncle = grandparent->rightchild;
+            if(isRed(uncle))
+            {
+                parent->red = false;
+                uncle->red = false;
+                grandparent->red = true;
+                node = grandparent;
+                continue;
+            }
+            if(node == parent->rightchild)
+            {
+                node = parent;
+                rotateLeft(node);
+                parent = node->parent;
+            }
+            parent->red = false;
+            grandparent->red = true;
+            rotateRight(grandparent);
+        }
+        else
+        {
+            TreeNode* uncle = grandparent->leftchild;
+            if(isRed(uncle))
+            {
+                parent->red = false;
+                uncle->red = false;
+                grandparent->red = true;
+                node = grandparent;
+                continue;
+            }
+            if(node == parent->leftchild)
+            {
+                node = parent;
+                rotateRight(node);
+                parent = node->parent;
+            }
+            parent->red = false;
+            grandparent->red = true;
+            rotateLeft(grandparent);
+        }
+    }
+    root->red = false;
+}
+
+// node niesie "dodatkowy czarny" po usunieciu czarnego wezla; parent potrzebny, bo node moze byc nullptr
+void removeFixup(TreeNode* node, TreeNode* parent)
+{
+    while(node != root && !isRed(node))
+    {
+        if(node == parent->leftchild)
+        {
+            TreeNode* sibling = parent->rightchild;
+            if(isRed(sibling))
+            {
+                sibling->red = false;
+                parent->red = true;
+                rotateLeft(parent);
+                sibling = parent->rightchild;
+            }
+            if(!isRed(sibling->leftchild) && !isRed(sibling->rightchild))
+            {
+                sibling->red = true;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+            if(!isRed(sibling->rightchild))
+            {
+                sibling->leftchild->red = false;
+                sibling->red = true;
+                rotateRight(sibling);
+                sibling = parent->rightchild;
+            }
+            sibling->red = parent->red;
+            parent->red = false;
+            sibling->rightchild->red = false;
+            rotateLeft(parent);
+            node = root;
+        }
+        else
+        {
+            TreeNode* sibling = parent->leftchild;
+            if(isRed(sibling))
+            {
+                sibling->red = false;
+                parent->red = true;
+                rotateRight(parent);
+                sibling = parent->leftchild;
+            }
+            if(!isRed(sibling->leftchild) && !isRed(sibling->rightchild))
+            {
+                sibling->red = true;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+            if(!isRed(sibling->leftchild))
+            {
+                sibling->rightchild->red = false;
+                sibling->red = true;
+                rotateLeft(sibling);
+                sibling = parent->leftchild;
+            }
+            sibling->red = parent->red;
+            parent->red = false;
+            sibling->leftchild->red = false;
+            rotateRight(parent);
+            node = root;
+        }
+    }
+    if(node != nullptr)
+        node->red = false;
+}
+
+
+TreeNode* findNode(const key_type& key) const
+{
+
+    TreeNode* temp = root;
+        while(temp != nullptr && temp->datapair.first != key)
+        {
+            if(key > temp->datapair.first)
+                temp = temp -> rightchild;
+
+            else
+                temp = temp -> leftchild;
+        }
+
+    return temp;
+
+}
+
+TreeNode* findMax(TreeNode* temp) const
+    {
+        if(root == nullptr)
+            return nullptr;
+
+        while(temp->rightchild != nullptr)
+            temp = temp->rightchild;
+        return temp;
     }
 
 
@@ -307,16 +1470,8 @@ TreeNode* findMin(TreeNode* temp) const
 
 void insert(TreeNode* newNode)
     {
-        node_counter++;
         TreeNode* curr_parent = nullptr;
         TreeNode* curr = root;
-        if (root == nullptr)
-            {
-                root = newNode;
-                return;
-            }
-
-        curr = root;
 
         while (curr != nullptr)
             {
@@ -326,13 +1481,185 @@ void insert(TreeNode* newNode)
                 else
                     curr = curr->leftchild;
             }
-        if(curr_parent->datapair.first < newNode->datapair.first)
-            curr_parent->rightchild = newNode;
+        attachNode(curr_parent, newNode);
+    }
+
+// doczepia nowy lisc pod parent (nullptr dla pustego drzewa) po stronie wynikajacej z klucza
+void attachNode(TreeNode* parent, TreeNode* newNode)
+{
+    node_counter++;
+    if(parent == nullptr)
+    {
+        root = newNode;
+        root->red = false;
+        head = tail = newNode;
+        return;
+    }
+
+    // nowy lisc sasiaduje w kolejnosci kluczy ze swoim rodzicem
+    if(parent->datapair.first < newNode->datapair.first)
+    {
+        parent->rightchild = newNode;
+        linkAfter(parent, newNode);
+    }
+    else
+    {
+        parent->leftchild = newNode;
+        linkBefore(parent, newNode);
+    }
+    newNode->parent = parent;
+    for(TreeNode* temp = parent; temp != nullptr; temp = temp->parent)
+        temp->size++;
+    insertFixup(newNode);
+}
+
+TreeNode* checkedHint(const const_iterator& hint) const
+{
+    if(hint.tree != this)
+        throw std::out_of_range("hint from another map");
+    return hint.curr_node;
+}
+
+// wezel z kluczem key albo nullptr i parent, pod ktory trzeba by doczepic nowy wezel.
+// Najpierw sprawdzana jest luka miedzy hint (nullptr to end()) a jego poprzednikiem i luka
+// za hint; dopiero gdy key lezy dalej, zaczyna sie wspinaczka od blizszego sasiada.
+TreeNode* fingerNode(TreeNode* hint, const key_type& key, TreeNode*& parent) const
+{
+    parent = nullptr;
+    if(root == nullptr)
+        return nullptr;
+
+    TreeNode* before = hint != nullptr ? hint->prev : tail;
+    TreeNode* after = hint;
+    if(after != nullptr && after->datapair.first < key)
+    {
+        before = after;
+        after = after->next;
+    }
+
+    if(before != nullptr && !(before->datapair.first < key))
+    {
+        if(!(key < before->datapair.first))
+            return before;
+        return descendFrom(climbFrom(before, key), key, parent);
+    }
+    if(after != nullptr && !(key < after->datapair.first))
+    {
+        if(!(after->datapair.first < key))
+            return after;
+        return descendFrom(climbFrom(after, key), key, parent);
+    }
+
+    // before < key < after - sasiedzi w kolejnosci, wiec jeden z nich ma wolne miejsce od strony key
+    parent = (before != nullptr && before->rightchild == nullptr) ? before : after;
+    return nullptr;
+}
+
+// najnizszy przodek start (lub on sam), ktorego poddrzewo obejmuje przedzial zawierajacy key
+TreeNode* climbFrom(TreeNode* start, const key_type& key) const
+{
+    TreeNode* temp = start;
+    if(key < start->datapair.first)
+    {
+        while(temp->parent != nullptr && key < temp->parent->datapair.first)
+            temp = temp->parent;
+    }
+    else
+    {
+        while(temp->parent != nullptr && temp->parent->datapair.first < key)
+            temp = temp->parent;
+    }
+    // rodzic, na ktorym zatrzymala sie wspinaczka, moze miec szukany klucz
+    if(temp->parent != nullptr && !(temp->parent->datapair.first < key) && !(key < temp->parent->datapair.first))
+        return temp->parent;
+    return temp;
+}
+
+TreeNode* descendFrom(TreeNode* temp, const key_type& key, TreeNode*& parent) const
+{
+    while(temp != nullptr)
+    {
+        if(temp->datapair.first < key)
+        {
+            parent = temp;
+            temp = temp->rightchild;
+        }
+        else if(key < temp->datapair.first)
+        {
+            parent = temp;
+            temp = temp->leftchild;
+        }
         else
-            curr_parent->leftchild = newNode;
-        newNode->parent = curr_parent;
+            return temp;
+    }
+    return nullptr;
+}
 
+TreeNode* createNode(const value_type& item)
+{
+    TreeNode* node = NodeTraits::allocate(node_alloc, 1);
+    try
+    {
+        NodeTraits::construct(node_alloc, node, item);
     }
+    catch(...)
+    {
+        NodeTraits::deallocate(node_alloc, node, 1);
+        throw;
+    }
+    return node;
+}
+
+void destroyNode(TreeNode* node)
+{
+    NodeTraits::destroy(node_alloc, node);
+    NodeTraits::deallocate(node_alloc, node, 1);
+}
+
+void cloneFrom(const TreeMap& other)
+{
+    TreeNode* previous = nullptr;
+    try
+    {
+        root = copyTree(other.root, nullptr, previous);
+    }
+    catch(...)
+    {
+        root = head = tail = nullptr;
+        throw;
+    }
+    tail = previous;
+    node_counter = other.node_counter;
+}
+
+// kopiuje in-order, zeby od razu polaczyc wezly w liste; previous to ostatni skopiowany wezel
+TreeNode* copyTree(const TreeNode* source, TreeNode* parent, TreeNode*& previous)
+{
+    if(source == nullptr)
+        return nullptr;
+
+    TreeNode* node = createNode(source->datapair);
+    node->parent = parent;
+    node->red = source->red;
+    node->size = source->size;
+    try
+    {
+        node->leftchild = copyTree(source->leftchild, node, previous);
+        node->prev = previous;
+        if(previous != nullptr)
+            previous->next = node;
+        else
+            head = node;
+        previous = node;
+        node->rightchild = copyTree(source->rightchild, node, previous);
+    }
+    catch(...)
+    {
+        removeAllNodes(node);
+        throw;
+    }
+    return node;
+}
 
 void removeAllNodes(TreeNode * temp)
 {
@@ -340,7 +1667,7 @@ void removeAllNodes(TreeNode * temp)
         return;
     removeAllNodes(temp->leftchild);
     removeAllNodes(temp->rightchild);
-    delete temp;
+    destroyNode(temp);
 }
 
 void removeTree()
@@ -350,15 +1677,17 @@ void removeTree()
     removeAllNodes(root->leftchild);
     removeAllNodes(root->rightchild);
     node_counter=0;
-    delete root;
+    destroyNode(root);
     root = nullptr;
+    head = nullptr;
+    tail = nullptr;
 }
 
 
 };
 
-template <typename KeyType, typename ValueType>
-class TreeMap<KeyType, ValueType>::ConstIterator
+template <typename KeyType, typename ValueType, typename Allocator>
+class TreeMap<KeyType, ValueType, Allocator>::ConstIterator
 {
 
 
@@ -372,7 +1701,7 @@ public:
 private:
   const TreeMap *tree;
     TreeNode *curr_node;
-  friend void TreeMap<KeyType, ValueType>::remove(const const_iterator&);
+  friend class TreeMap;
 
 
 public:
@@ -385,18 +1714,7 @@ explicit ConstIterator(const TreeMap* tree, TreeNode* node): tree(tree), curr_no
   {
     if(tree==nullptr||curr_node ==nullptr)
         throw std::out_of_range("operator++ out of range");
-    if(curr_node->rightchild)
-    {
-        curr_node=curr_node->rightchild;
-        while(curr_node->leftchild!=nullptr)
-            curr_node=curr_node->leftchild;
-    }
-    else
-    {
-        while(curr_node->parent != nullptr && curr_node->parent->rightchild == curr_node)
-            curr_node=curr_node->parent;
-        curr_node=curr_node->parent;
-    }
+    curr_node = curr_node->next;
     return *this;
   }
 
@@ -414,25 +1732,13 @@ explicit ConstIterator(const TreeMap* tree, TreeNode* node): tree(tree), curr_no
     throw std::out_of_range("operator-- outofrange");
 
     else if(curr_node == nullptr)
-    {
-        curr_node = tree->root;
-            while(curr_node->rightchild != nullptr)
-                curr_node=curr_node->rightchild;
-    }
+        curr_node = tree->tail;
 
+    else if(curr_node->prev == nullptr)
+        throw std::out_of_range("operator-- outofrange");
 
-    else if(curr_node->leftchild)
-    {
-        curr_node=curr_node->leftchild;
-        while(curr_node->rightchild!=nullptr)
-            curr_node=curr_node->rightchild;
-    }
     else
-    {
-        while(curr_node->parent != nullptr && curr_node->parent->leftchild == curr_node)
-            curr_node=curr_node->parent;
-        curr_node=curr_node->parent;
-    }
+        curr_node = curr_node->prev;
 
     return *this;
   }
@@ -471,8 +1777,8 @@ explicit ConstIterator(const TreeMap* tree, TreeNode* node): tree(tree), curr_no
 
 };
 
-template <typename KeyType, typename ValueType>
-class TreeMap<KeyType, ValueType>::Iterator : public TreeMap<KeyType, ValueType>::ConstIterator
+template <typename KeyType, typename ValueType, typename Allocator>
+class TreeMap<KeyType, ValueType, Allocator>::Iterator : public TreeMap<KeyType, ValueType, Allocator>::ConstIterator
 {
 public:
   using reference = typename TreeMap::reference;
@@ -1,8 +1,10 @@
 #include <TreeMap.h>
 
 #include <cstdint>
+#include <iterator>
 #include <string>
 #include <map>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -496,7 +498,7 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenRemovingValueByKey_ThenItemIs
 
   map.remove(27);
 
- // thenMapContainsItems(map, { { 42, "Alice" } });
+  thenMapContainsItems(map, { { 42, "Alice" } });
 }
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSingleItemMap_WhenRemovingValueByKey_ThenMapBecomesEmpty,
@@ -591,6 +593,706 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoMapsWithDifferentKeys_WhenComparingThem_Th
   BOOST_CHECK(map != other);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenAddingAscendingKeys_ThenHeightStaysLogarithmic,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+
+  for (K i = 0; i < 100000; ++i)
+    map[i] = "x";
+
+  BOOST_CHECK_EQUAL(map.getSize(), 100000u);
+  BOOST_CHECK_LE(map.height(), 34u);
+  BOOST_CHECK_EQUAL(begin(map)->first, K{0});
+  BOOST_CHECK_EQUAL((--end(map))->first, K{99999});
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenRemovingEveryOtherAscendingKey_ThenRestIsInOrderAndBalanced,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (K i = 0; i < 4096; ++i)
+    map[i] = "x";
+
+  for (K i = 0; i < 4096; i += 2)
+    map.remove(i);
+
+  BOOST_CHECK_EQUAL(map.getSize(), 2048u);
+  BOOST_CHECK_LE(map.height(), 24u);
+  K expected = 1;
+  for (const auto& item : map)
+  {
+    BOOST_CHECK_EQUAL(item.first, expected);
+    expected += 2;
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenMixingInsertsAndRemovals_ThenItMatchesStdMap,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  std::uint32_t seed = 12345;
+
+  for (int i = 0; i < 20000; ++i)
+  {
+    seed = seed * 1103515245u + 12345u;
+    const K key = static_cast<K>((seed >> 8) % 2000);
+    if ((seed >> 4) % 3 == 0 && map.find(key) != end(map))
+    {
+      map.remove(key);
+      expected.erase(key);
+    }
+    else
+    {
+      map[key] = std::to_string(i);
+      expected[key] = std::to_string(i);
+    }
+  }
+
+  thenMapContainsItems(map, expected);
+  BOOST_CHECK_LE(map.height(), 22u);
+  auto it = begin(expected);
+  for (const auto& item : map)
+    BOOST_CHECK_EQUAL(item.first, (it++)->first);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenAskingForOrderStatistics_ThenNothingIsFound,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map;
+
+  BOOST_CHECK_EQUAL(map.rank(42), 0u);
+  BOOST_CHECK(map.select(0) == end(map));
+  BOOST_CHECK_EQUAL(map.countInRange(0, 100), 0u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenAskingForRank_ThenNumberOfSmallerKeysIsReturned,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map = { { 10, "a" }, { 20, "b" }, { 30, "c" }, { 40, "d" } };
+
+  BOOST_CHECK_EQUAL(map.rank(5), 0u);
+  BOOST_CHECK_EQUAL(map.rank(10), 0u);
+  BOOST_CHECK_EQUAL(map.rank(11), 1u);
+  BOOST_CHECK_EQUAL(map.rank(40), 3u);
+  BOOST_CHECK_EQUAL(map.rank(41), 4u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenSelectingKthItem_ThenItemIsReturned,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 30, "c" }, { 10, "a" }, { 40, "d" }, { 20, "b" } };
+
+  BOOST_CHECK_EQUAL(map.select(0)->second, "a");
+  BOOST_CHECK_EQUAL(map.select(2)->second, "c");
+  BOOST_CHECK_EQUAL(map.select(3)->first, K{40});
+  BOOST_CHECK(map.select(4) == end(map));
+
+  map.select(1)->second = "x";
+  BOOST_CHECK_EQUAL(map.valueOf(20), "x");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenCountingRange_ThenHalfOpenIntervalIsCounted,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map = { { 10, "a" }, { 20, "b" }, { 30, "c" }, { 40, "d" } };
+
+  BOOST_CHECK_EQUAL(map.countInRange(10, 40), 3u);
+  BOOST_CHECK_EQUAL(map.countInRange(10, 41), 4u);
+  BOOST_CHECK_EQUAL(map.countInRange(11, 20), 0u);
+  BOOST_CHECK_EQUAL(map.countInRange(40, 10), 0u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapAfterManyRemovals_WhenAskingForOrderStatistics_ThenTheyMatchOrder,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  std::uint32_t seed = 777;
+
+  for (int i = 0; i < 5000; ++i)
+  {
+    seed = seed * 1103515245u + 12345u;
+    const K key = static_cast<K>((seed >> 8) % 1000);
+    if ((seed >> 4) % 2 == 0 && map.find(key) != end(map))
+    {
+      map.remove(key);
+      expected.erase(key);
+    }
+    else
+    {
+      map[key] = "x";
+      expected[key] = "x";
+    }
+  }
+
+  std::size_t index = 0;
+  for (const auto& item : expected)
+  {
+    BOOST_CHECK_EQUAL(map.rank(item.first), index);
+    BOOST_CHECK_EQUAL(map.select(index)->first, item.first);
+    ++index;
+  }
+  BOOST_CHECK_EQUAL(map.countInRange(100, 600),
+                    static_cast<std::size_t>(std::distance(expected.lower_bound(100), expected.lower_bound(600))));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenAskingForBounds_ThenProperItemsAreReturned,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 10, "a" }, { 20, "b" }, { 30, "c" } };
+
+  BOOST_CHECK_EQUAL(map.lowerBound(20)->second, "b");
+  BOOST_CHECK_EQUAL(map.lowerBound(11)->second, "b");
+  BOOST_CHECK_EQUAL(map.upperBound(20)->second, "c");
+  BOOST_CHECK_EQUAL(map.upperBound(5)->second, "a");
+  BOOST_CHECK(map.lowerBound(31) == end(map));
+  BOOST_CHECK(map.upperBound(30) == end(map));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenAskingForEqualRange_ThenRangeHoldsMatchingKey,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map = { { 10, "a" }, { 20, "b" }, { 30, "c" } };
+
+  const auto found = map.equalRange(20);
+  BOOST_CHECK_EQUAL(found.first->second, "b");
+  BOOST_CHECK_EQUAL(found.second->second, "c");
+
+  const auto missing = map.equalRange(25);
+  BOOST_CHECK(missing.first == missing.second);
+  BOOST_CHECK_EQUAL(missing.first->second, "c");
+
+  const auto last = map.equalRange(30);
+  BOOST_CHECK(last.second == end(map));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenRemovingSmallRange_ThenOnlyKeysInsideAreRemoved,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (K i = 0; i < 1000; ++i)
+    map[i] = "x";
+
+  map.removeRange(100, 110);
+
+  BOOST_CHECK_EQUAL(map.getSize(), 990u);
+  BOOST_CHECK(map.find(99) != end(map));
+  BOOST_CHECK(map.find(100) == end(map));
+  BOOST_CHECK(map.find(109) == end(map));
+  BOOST_CHECK(map.find(110) != end(map));
+  BOOST_CHECK_EQUAL(map.rank(500), 490u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenRemovingLargeRange_ThenTreeStaysBalancedAndUsable,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (K i = 0; i < 10000; ++i)
+    map[i] = "x";
+
+  map.removeRange(1000, 9500);
+
+  BOOST_CHECK_EQUAL(map.getSize(), 1500u);
+  BOOST_CHECK_LE(map.height(), 12u);
+  BOOST_CHECK_EQUAL(map.select(1000)->first, K{9500});
+  BOOST_CHECK_EQUAL((--end(map))->first, K{9999});
+
+  for (K i = 20000; i < 21000; ++i)
+    map[i] = "y";
+  for (K i = 0; i < 1000; ++i)
+    map.remove(i);
+  BOOST_CHECK_EQUAL(map.getSize(), 1500u);
+  BOOST_CHECK_EQUAL(begin(map)->first, K{9500});
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenRemovingEverything_ThenMapBecomesEmpty,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 10, "a" }, { 20, "b" }, { 30, "c" } };
+
+  map.removeRange(0, 100);
+  map.removeRange(5, 1);
+
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(begin(map) == end(map));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeMap_WhenCopying_ThenCopyHasSameShapeAndIsIndependent,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (K i = 0; i < 50000; ++i)
+    map[i] = "x";
+
+  Map<K> copy{map};
+  BOOST_CHECK_EQUAL(copy.height(), map.height());
+
+  map.remove(7);
+  copy[7] = "y";
+
+  BOOST_CHECK_EQUAL(copy.getSize(), 50000u);
+  BOOST_CHECK_EQUAL(copy.select(7)->second, "y");
+  BOOST_CHECK_EQUAL(copy.rank(40000), 40000u);
+  BOOST_CHECK(map.find(7) == end(map));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeMap_WhenCopyAssigning_ThenTargetHoldsSameItems,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (K i = 0; i < 20000; ++i)
+    map[i] = "x";
+  Map<K> other = { { 123456, "old" } };
+
+  other = map;
+
+  BOOST_CHECK(other == map);
+  BOOST_CHECK(other.find(123456) == end(other));
+  other.removeRange(0, 10000);
+  BOOST_CHECK_EQUAL(map.getSize(), 20000u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSortedPairs_WhenBuildingFromSorted_ThenTreeIsPerfectlyBalanced,
+                              K,
+                              TestedKeyTypes)
+{
+  std::vector<std::pair<K, std::string>> items;
+  for (K i = 0; i < 1023; ++i)
+    items.emplace_back(i * 2, std::to_string(i));
+
+  Map<K> map = Map<K>::fromSorted(items.begin(), items.end());
+
+  BOOST_CHECK_EQUAL(map.getSize(), 1023u);
+  BOOST_CHECK_EQUAL(map.height(), 10u);
+  BOOST_CHECK_EQUAL(map.valueOf(100), "50");
+  BOOST_CHECK_EQUAL(map.select(1022)->first, K{2044});
+
+  for (K i = 0; i < 1000; ++i)
+    map[i * 2 + 1] = "odd";
+  BOOST_CHECK_EQUAL(map.getSize(), 2023u);
+  BOOST_CHECK_LE(map.height(), 22u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSortedPairsWithDuplicates_WhenBuildingFromSorted_ThenLastValueWins,
+                              K,
+                              TestedKeyTypes)
+{
+  const std::map<K, std::string> empty;
+  BOOST_CHECK(Map<K>::fromSorted(empty.begin(), empty.end()).isEmpty());
+
+  const std::vector<std::pair<K, std::string>> items = { { 1, "a" }, { 2, "b" }, { 2, "c" }, { 3, "d" } };
+  const Map<K> map = Map<K>::fromSorted(items.begin(), items.end());
+
+  thenMapContainsItems(map, { { 1, "a" }, { 2, "c" }, { 3, "d" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenUnsortedPairs_WhenBuildingFromSorted_ThenExceptionIsThrown,
+                              K,
+                              TestedKeyTypes)
+{
+  const std::vector<std::pair<K, std::string>> items = { { 1, "a" }, { 3, "b" }, { 2, "c" } };
+
+  BOOST_CHECK_THROW(Map<K>::fromSorted(items.begin(), items.end()), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenDecrementingBegin_ThenOperationThrows,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 10, "a" }, { 20, "b" } };
+
+  BOOST_CHECK_THROW(--(map.begin()), std::out_of_range);
+  BOOST_CHECK_THROW(--(map.cbegin()), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapAfterMixedOperations_WhenIteratingBothWays_ThenOrderMatchesStdMap,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  std::uint32_t seed = 4242;
+
+  for (int i = 0; i < 8000; ++i)
+  {
+    seed = seed * 1103515245u + 12345u;
+    const K key = static_cast<K>((seed >> 8) % 3000);
+    if ((seed >> 4) % 3 == 0 && map.find(key) != end(map))
+    {
+      map.remove(key);
+      expected.erase(key);
+    }
+    else
+    {
+      map[key] = "x";
+      expected[key] = "x";
+    }
+  }
+  map.removeRange(100, 200);
+  expected.erase(expected.lower_bound(100), expected.lower_bound(200));
+  const Map<K> copy = map;
+
+  auto forward = begin(expected);
+  for (auto it = begin(copy); it != end(copy); ++it, ++forward)
+    BOOST_CHECK_EQUAL(it->first, forward->first);
+  BOOST_CHECK(forward == end(expected));
+
+  auto backward = expected.rbegin();
+  for (auto it = end(map); it != begin(map); ++backward)
+  {
+    --it;
+    BOOST_CHECK_EQUAL(it->first, backward->first);
+  }
+  BOOST_CHECK(backward == expected.rend());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeMap_WhenSplitting_ThenBothPartsAreBalancedAndOrdered,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (K i = 0; i < 10000; ++i)
+    map[i] = "x";
+
+  Map<K> upper = map.split(3000);
+
+  BOOST_CHECK_EQUAL(map.getSize(), 3000u);
+  BOOST_CHECK_EQUAL(upper.getSize(), 7000u);
+  BOOST_CHECK_LE(map.height(), 24u);
+  BOOST_CHECK_LE(upper.height(), 26u);
+  BOOST_CHECK_EQUAL((--end(map))->first, K{2999});
+  BOOST_CHECK_EQUAL(begin(upper)->first, K{3000});
+  BOOST_CHECK_EQUAL(upper.select(5000)->first, K{8000});
+  BOOST_CHECK_EQUAL(upper.rank(9000), 6000u);
+
+  upper[1] = "y";
+  map.remove(0);
+  BOOST_CHECK_EQUAL(begin(upper)->second, "y");
+  BOOST_CHECK_EQUAL(begin(map)->first, K{1});
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenSplittingOutsideItsKeys_ThenOnePartIsEmpty,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 10, "a" }, { 20, "b" } };
+
+  Map<K> upper = map.split(30);
+  BOOST_CHECK(upper.isEmpty());
+  BOOST_CHECK_EQUAL(map.getSize(), 2u);
+
+  upper = map.split(10);
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(begin(map) == end(map));
+  thenMapContainsItems(upper, { { 10, "a" }, { 20, "b" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSplitMap_WhenJoiningParts_ThenOriginalMapIsRestored,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (K i = 0; i < 5000; ++i)
+    map[i * 3] = std::to_string(i);
+  const Map<K> original = map;
+
+  for (K key = 7; key < 15000; key += 1499)
+  {
+    Map<K> upper = map.split(key);
+    map = Map<K>::join(std::move(map), std::move(upper));
+  }
+
+  BOOST_CHECK(map == original);
+  BOOST_CHECK_LE(map.height(), 26u);
+  BOOST_CHECK_EQUAL(map.select(2500)->second, "2500");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapsOfDifferentHeights_WhenJoining_ThenResultIsBalanced,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> left = { { 1, "a" } };
+  Map<K> right;
+  for (K i = 100; i < 20100; ++i)
+    right[i] = "b";
+
+  Map<K> joined = Map<K>::join(std::move(left), std::move(right));
+
+  BOOST_CHECK(left.isEmpty());
+  BOOST_CHECK(right.isEmpty());
+  BOOST_CHECK_EQUAL(joined.getSize(), 20001u);
+  BOOST_CHECK_LE(joined.height(), 30u);
+  BOOST_CHECK_EQUAL(joined.select(1)->first, K{100});
+  BOOST_CHECK_EQUAL((--end(joined))->first, K{20099});
+
+  Map<K> overlapping = { { 50, "c" } };
+  BOOST_CHECK_THROW(Map<K>::join(std::move(joined), std::move(overlapping)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoMaps_WhenMakingUnion_ThenExistingValuesWin,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 1, "a" }, { 3, "b" }, { 5, "c" } };
+  const Map<K> other = { { 2, "x" }, { 3, "y" }, { 7, "z" } };
+
+  map.unionWith(other);
+
+  thenMapContainsItems(map, { { 1, "a" }, { 2, "x" }, { 3, "b" }, { 5, "c" }, { 7, "z" } });
+  BOOST_CHECK_EQUAL(other.getSize(), 3u);
+
+  Map<K> moved = { { 0, "m" }, { 5, "n" } };
+  map.unionWith(std::move(moved));
+  BOOST_CHECK(moved.isEmpty());
+  BOOST_CHECK_EQUAL(map.getSize(), 6u);
+  BOOST_CHECK_EQUAL(begin(map)->second, "m");
+  BOOST_CHECK_EQUAL(map.valueOf(5), "c");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeMaps_WhenCombiningThem_ThenResultsMatchStdMap,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> evens;
+  Map<K> triples;
+  std::map<K, std::string> expectedUnion;
+  std::map<K, std::string> expectedIntersection;
+  std::map<K, std::string> expectedDifference;
+  for (K i = 0; i < 6000; ++i)
+  {
+    if (i % 2 == 0)
+      evens[i] = expectedUnion[i] = "2";
+    if (i % 3 == 0)
+    {
+      triples[i] = "3";
+      expectedUnion.emplace(i, "3");
+    }
+    if (i % 6 == 0)
+      expectedIntersection[i] = "2";
+    else if (i % 2 == 0)
+      expectedDifference[i] = "2";
+  }
+
+  Map<K> merged = evens;
+  merged.unionWith(triples);
+  Map<K> common = evens;
+  common.intersectWith(triples);
+  Map<K> rest = evens;
+  rest.differenceWith(triples);
+
+  thenMapContainsItems(merged, expectedUnion);
+  thenMapContainsItems(common, expectedIntersection);
+  thenMapContainsItems(rest, expectedDifference);
+  BOOST_CHECK_LE(merged.height(), 24u);
+  BOOST_CHECK_EQUAL(rest.select(1)->first, K{4});
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeMap_WhenSubtractingFewKeys_ThenOnlyThoseAreRemoved,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (K i = 0; i < 10000; ++i)
+    map[i] = "x";
+  const Map<K> few = { { 5, "a" }, { 500, "b" }, { 20000, "c" } };
+
+  map.differenceWith(few);
+  BOOST_CHECK_EQUAL(map.getSize(), 9998u);
+  BOOST_CHECK(map.find(500) == end(map));
+
+  map.intersectWith(few);
+  BOOST_CHECK(map.isEmpty());
+
+  Map<K> self = { { 1, "a" } };
+  self.differenceWith(self);
+  BOOST_CHECK(self.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenAppendingWithEndHint_ThenItemsAreInOrderAndBalanced,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+
+  for (K i = 0; i < 50000; ++i)
+    BOOST_CHECK_EQUAL(map.insert(end(map), i, "x")->first, i);
+
+  BOOST_CHECK_EQUAL(map.getSize(), 50000u);
+  BOOST_CHECK_LE(map.height(), 32u);
+  BOOST_CHECK_EQUAL(map.rank(25000), 25000u);
+  BOOST_CHECK_EQUAL((--end(map))->first, K{49999});
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenInsertingWithHint_ThenExistingValueIsKept,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 10, "a" }, { 20, "b" }, { 30, "c" } };
+
+  auto it = map.insert(map.find(30), 20, "x");
+  BOOST_CHECK_EQUAL(it->second, "b");
+  it = map.insert(it, 25, "d");
+  it = map.insert(it, 26, "e");
+  map.insert(begin(map), 40, "f");
+  map.insert(end(map), 5, "g");
+
+  thenMapContainsItems(map, { { 5, "g" }, { 10, "a" }, { 20, "b" }, { 25, "d" },
+                              { 26, "e" }, { 30, "c" }, { 40, "f" } });
+  BOOST_CHECK_EQUAL((++it)->first, K{30});
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenHintFromAnotherMap_WhenUsingIt_ThenExceptionIsThrown,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 10, "a" } };
+  Map<K> other = { { 10, "a" } };
+
+  BOOST_CHECK_THROW(map.insert(begin(other), 20, "b"), std::out_of_range);
+  BOOST_CHECK_THROW(map.find(end(other), 10), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeMap_WhenFindingFromHint_ThenResultMatchesPlainFind,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (K i = 0; i < 3000; ++i)
+    map[i * 2] = std::to_string(i);
+
+  auto hint = begin(map);
+  for (K key = 0; key < 6002; key += 7)
+  {
+    const auto found = map.find(hint, key);
+    BOOST_CHECK(found == map.find(key));
+    if (found != end(map))
+      hint = found;
+  }
+
+  const auto middle = map.find(3000);
+  BOOST_CHECK(map.find(middle, 3001) == end(map));
+  BOOST_CHECK_EQUAL(map.find(middle, 2)->second, "1");
+  BOOST_CHECK_EQUAL(map.find(middle, 5998)->second, "2999");
+  BOOST_CHECK_EQUAL(map.find(end(map), 5998)->second, "2999");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInsertingWithRandomHints_ThenItMatchesStdMap,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  std::uint32_t seed = 777;
+
+  for (int i = 0; i < 5000; ++i)
+  {
+    seed = seed * 1103515245u + 12345u;
+    const K key = static_cast<K>((seed >> 8) % 2000);
+    const auto hint = map.isEmpty() ? end(map) : map.select((seed >> 4) % map.getSize());
+    map.insert(hint, key, std::to_string(i));
+    expected.emplace(key, std::to_string(i));
+  }
+
+  thenMapContainsItems(map, expected);
+  BOOST_CHECK_LE(map.height(), 22u);
+  auto it = begin(expected);
+  for (const auto& item : map)
+    BOOST_CHECK_EQUAL(item.first, (it++)->first);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyItems_WhenUsingParallelForEach_ThenEachItemIsVisitedOnce,
+                              K,
+                              TestedKeyTypes)
+{
+  aisdi::ThreadPool pool(3);
+  Map<K> map;
+  for (K i = 0; i < 5000; ++i)
+    map[i] = "x";
+
+  map.parallelForEach([](typename Map<K>::value_type& item) { item.second += std::to_string(item.first); }, pool);
+
+  for (K i = 0; i < 5000; ++i)
+    BOOST_CHECK_EQUAL(map.valueOf(i), "x" + std::to_string(i));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyItems_WhenUsingParallelReduce_ThenPartialResultsAreCombinedInKeyOrder,
+                              K,
+                              TestedKeyTypes)
+{
+  aisdi::ThreadPool pool(3);
+  Map<K> map;
+  std::string expected;
+  for (K i = 0; i < 3000; ++i)
+  {
+    map[i] = std::string(1, static_cast<char>('a' + i % 26));
+    expected += map[i];
+  }
+
+  const std::string joined = map.parallelReduce(std::string(),
+                                                [](const typename Map<K>::value_type& item) { return item.second; },
+                                                [](const std::string& left, const std::string& right) { return left + right; },
+                                                pool);
+
+  BOOST_CHECK_EQUAL(joined, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenUnsortedItemsWithDuplicates_WhenBuildingFromUnsorted_ThenLastValueWinsAndTreeIsBalanced,
+                              K,
+                              TestedKeyTypes)
+{
+  aisdi::ThreadPool pool(3);
+  std::vector<std::pair<K, std::string>> items;
+  std::map<K, std::string> expected;
+  std::uint32_t seed = 777;
+  for (int i = 0; i < 60000; ++i)
+  {
+    seed = seed * 1103515245u + 12345u;
+    const K key = static_cast<K>((seed >> 8) % 40000);
+    items.emplace_back(key, std::to_string(i));
+    expected[key] = std::to_string(i);
+  }
+
+  const Map<K> map = Map<K>::fromUnsorted(items.begin(), items.end(), pool);
+
+  thenMapContainsItems(map, expected);
+  std::size_t levels = 0;
+  while ((std::size_t(1) << levels) <= map.getSize())
+    ++levels;
+  BOOST_CHECK_EQUAL(map.height(), levels);
+  BOOST_CHECK_EQUAL(map.select(expected.size() / 2)->first, std::next(expected.begin(), expected.size() / 2)->first);
+  auto it = end(map);
+  BOOST_CHECK_EQUAL((--it)->first, expected.rbegin()->first);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyRange_WhenBuildingFromUnsorted_ThenMapIsEmpty,
+                              K,
+                              TestedKeyTypes)
+{
+  const std::vector<std::pair<K, std::string>> items;
+
+  const Map<K> map = Map<K>::fromUnsorted(items.begin(), items.end());
+
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(begin(map) == end(map));
+}
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 
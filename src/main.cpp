@@ -1,12 +1,25 @@
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
 #include <string>
 #include <chrono>
 #include <ctime>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "TreeMap.h"
+#include "BPlusTreeMap.h"
+#include "CompactTreeMap.h"
 #include "HashMap.h"
+#include "SwissHashMap.h"
+#include "RobinHoodHashMap.h"
+#include "ConcurrentHashMap.h"
+#include "ConcurrentSkipListMap.h"
+#include "ReadMostlyHashMap.h"
+#include "ShardedMap.h"
 
 namespace
 {
@@ -14,16 +27,319 @@ namespace
 template <typename K, typename V>
 using Map = aisdi::HashMap<K, V>;
 template <typename K, typename V>
+using SwissMap = aisdi::SwissHashMap<K, V>;
+template <typename K, typename V>
+using RobinHoodMap = aisdi::RobinHoodHashMap<K, V>;
+template <typename K, typename V>
 using Tree = aisdi::TreeMap<K, V>;
+template <typename K, typename V>
+using BPlusTree = aisdi::BPlusTreeMap<K, V>;
+template <typename K, typename V>
+using CompactTree = aisdi::CompactTreeMap<K, V>;
+
+template <template <typename, typename> class MapType>
+void perfomLookupTest(std::size_t repeatCount, std::size_t tableSize, const char* name)
+{
+  std::chrono::time_point<std::chrono::system_clock> start, end;
+  std::chrono::duration<double> elapsed_seconds;
+
+  MapType<int, std::string> map(tableSize);
+  for (std::size_t i = 0; i < repeatCount; i++)
+    map[rand()%1000000]= "word";
+
+  std::size_t found = 0;
+  start = std::chrono::system_clock::now();
+  for (std::size_t i = 0; i < repeatCount; i++)
+    if (map.find(rand()%1000000) != map.end())
+      found++;
+  end = std::chrono::system_clock::now();
+  elapsed_seconds = end - start;
+  std::cout << "\t wyszukiwanie elementow w " << name << " (losowo klucze, trafien: " << found << ")\t czas: " << elapsed_seconds.count() << "s\n";
+}
+
+void perfomConcurrentTest(std::size_t repeatCount, std::size_t tableSize)
+{
+  aisdi::ConcurrentHashMap<int, std::string> map(tableSize);
+  for (std::size_t i = 0; i < repeatCount; i++)
+    map.insert(static_cast<int>(i), "word");
+
+  for (std::size_t threadCount = 1; threadCount <= 4; threadCount *= 2)
+  {
+    std::chrono::time_point<std::chrono::system_clock> start = std::chrono::system_clock::now();
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < threadCount; t++)
+      threads.emplace_back([&map, repeatCount, t]() {
+        std::string value;
+        for (std::size_t i = 0; i < repeatCount; i++)
+          map.find(static_cast<int>((i * 7919 + t) % repeatCount), value);
+      });
+    for (auto& thread : threads)
+      thread.join();
+    std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - start;
+    std::cout << "\t wyszukiwanie w ConcurrentHashMapie (" << threadCount << " watki, po " << repeatCount
+              << " odczytow)\t czas: " << elapsed_seconds.count() << "s\n";
+  }
+}
+
+// te same odczyty bez blokad, a w tle jeden piszacy zmienia wartosci
+void perfomReadMostlyTest(std::size_t repeatCount, std::size_t tableSize)
+{
+  aisdi::ReadMostlyHashMap<int, std::string> map(tableSize);
+  for (std::size_t i = 0; i < repeatCount; i++)
+    map.insert(static_cast<int>(i), "word");
+
+  for (std::size_t threadCount = 1; threadCount <= 4; threadCount *= 2)
+  {
+    std::atomic<bool> done(false);
+    std::thread writer([&map, &done, repeatCount]() {
+      for (std::size_t i = 0; !done; i++)
+      {
+        map.insertOrAssign(static_cast<int>(i % repeatCount), "other");
+        std::this_thread::yield();
+      }
+    });
+
+    std::chrono::time_point<std::chrono::system_clock> start = std::chrono::system_clock::now();
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < threadCount; t++)
+      threads.emplace_back([&map, repeatCount, t]() {
+        std::string value;
+        for (std::size_t i = 0; i < repeatCount; i++)
+          map.find(static_cast<int>((i * 7919 + t) % repeatCount), value);
+      });
+    for (auto& thread : threads)
+      thread.join();
+    std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - start;
+    done = true;
+    writer.join();
+    std::cout << "\t wyszukiwanie w ReadMostlyHashMapie (" << threadCount << " watki i piszacy, po " << repeatCount
+              << " odczytow)\t czas: " << elapsed_seconds.count() << "s\n";
+  }
+}
+
+// zapisy z kilku watkow: HashMap za jedna blokada i 16 HashMap, kazda z wlasna blokada
+void perfomShardedTest(std::size_t repeatCount)
+{
+  for (std::size_t threadCount = 1; threadCount <= 4; threadCount *= 2)
+  {
+    Map<int, int> single;
+    std::mutex singleLock;
+    std::chrono::time_point<std::chrono::system_clock> start = std::chrono::system_clock::now();
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < threadCount; t++)
+      threads.emplace_back([&single, &singleLock, repeatCount, threadCount, t]() {
+        for (std::size_t i = t; i < repeatCount; i += threadCount)
+        {
+          std::lock_guard<std::mutex> guard(singleLock);
+          single[static_cast<int>(i)] = static_cast<int>(i);
+        }
+      });
+    for (auto& thread : threads)
+      thread.join();
+    std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - start;
+    std::cout << "\t wstawianie do Hashmapy z blokada (" << threadCount << " watki, razem " << repeatCount
+              << ")\t czas: " << elapsed_seconds.count() << "s\n";
+
+    aisdi::ShardedMap<Map<int, int>, 16> sharded;
+    start = std::chrono::system_clock::now();
+    threads.clear();
+    for (std::size_t t = 0; t < threadCount; t++)
+      threads.emplace_back([&sharded, repeatCount, threadCount, t]() {
+        for (std::size_t i = t; i < repeatCount; i += threadCount)
+          sharded.insertOrAssign(static_cast<int>(i), static_cast<int>(i));
+      });
+    for (auto& thread : threads)
+      thread.join();
+    elapsed_seconds = std::chrono::system_clock::now() - start;
+    std::cout << "\t wstawianie do ShardedMap (" << threadCount << " watki, razem " << repeatCount
+              << ")\t czas: " << elapsed_seconds.count() << "s\n";
+  }
+}
+
+// odczyty z co osmym zapisem; TreeMap za jedna blokada, lista z przeskokami bez blokad
+void perfomConcurrentOrderedTest(std::size_t repeatCount)
+{
+  aisdi::ConcurrentSkipListMap<int, int> skipList;
+  Tree<int, int> tree;
+  std::mutex treeLock;
+  for (std::size_t i = 0; i < repeatCount; i++)
+  {
+    skipList.insert(static_cast<int>(i * 2), 0);
+    tree[static_cast<int>(i * 2)] = 0;
+  }
+
+  for (std::size_t threadCount = 1; threadCount <= 8; threadCount *= 2)
+  {
+    std::chrono::time_point<std::chrono::system_clock> start = std::chrono::system_clock::now();
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < threadCount; t++)
+      threads.emplace_back([&skipList, repeatCount, t]() {
+        for (std::size_t i = 0; i < repeatCount; i++)
+        {
+          const int key = static_cast<int>((i * 7919 + t) % (repeatCount * 2));
+          if (i % 8 == 0)
+            skipList.insertOrAssign(key, static_cast<int>(i));
+          else
+            skipList.contains(key);
+        }
+      });
+    for (auto& thread : threads)
+      thread.join();
+    std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - start;
+    std::cout << "\t operacje na liscie z przeskokami (" << threadCount << " watki, po " << repeatCount
+              << ")\t czas: " << elapsed_seconds.count() << "s\n";
+
+    start = std::chrono::system_clock::now();
+    threads.clear();
+    for (std::size_t t = 0; t < threadCount; t++)
+      threads.emplace_back([&tree, &treeLock, repeatCount, t]() {
+        for (std::size_t i = 0; i < repeatCount; i++)
+        {
+          const int key = static_cast<int>((i * 7919 + t) % (repeatCount * 2));
+          std::lock_guard<std::mutex> guard(treeLock);
+          if (i % 8 == 0)
+            tree[key] = static_cast<int>(i);
+          else
+            tree.find(key);
+        }
+      });
+    for (auto& thread : threads)
+      thread.join();
+    elapsed_seconds = std::chrono::system_clock::now() - start;
+    std::cout << "\t operacje na Drzewie z blokada (" << threadCount << " watki, po " << repeatCount
+              << ")\t czas: " << elapsed_seconds.count() << "s\n";
+  }
+}
+
+template <template <typename, typename> class MapType>
+void perfomOrderedTest(std::size_t repeatCount, const char* name)
+{
+  std::chrono::time_point<std::chrono::system_clock> start;
+  std::chrono::duration<double> elapsed_seconds;
+  MapType<int, int> map;
+
+  start = std::chrono::system_clock::now();
+  for (std::size_t i = 0; i < repeatCount; i++)
+    map[rand()] = static_cast<int>(i);
+  elapsed_seconds = std::chrono::system_clock::now() - start;
+  std::cout << "\t dodawanie " << repeatCount << " losowych kluczy w " << name << "\t czas: " << elapsed_seconds.count() << "s\n";
+
+  std::size_t found = 0;
+  start = std::chrono::system_clock::now();
+  for (std::size_t i = 0; i < repeatCount; i++)
+    if (map.find(rand()) != map.end())
+      found++;
+  elapsed_seconds = std::chrono::system_clock::now() - start;
+  std::cout << "\t wyszukiwanie w " << name << " (trafien: " << found << ")\t czas: " << elapsed_seconds.count() << "s\n";
+
+  long long sum = 0;
+  start = std::chrono::system_clock::now();
+  for (const auto& item : map)
+    sum += item.second;
+  elapsed_seconds = std::chrono::system_clock::now() - start;
+  std::cout << "\t przejscie po " << name << " (suma: " << sum << ")\t czas: " << elapsed_seconds.count() << "s\n";
+}
+
+// budowa drzewa z nieposortowanych kluczy: kolejne operator[] kontra fromUnsorted
+void perfomBulkLoadTest(std::size_t repeatCount)
+{
+  std::vector<std::pair<int, int>> items;
+  items.reserve(repeatCount);
+  for (std::size_t i = 0; i < repeatCount; i++)
+    items.emplace_back(static_cast<int>((i * 7919) % repeatCount), static_cast<int>(i));
+
+  std::chrono::time_point<std::chrono::system_clock> start = std::chrono::system_clock::now();
+  {
+    Tree<int, int> tree;
+    for (const auto& item : items)
+      tree[item.first] = item.second;
+  }
+  std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - start;
+  std::cout << "\t wstawianie nieposortowanych kluczy do Drzewa (" << repeatCount << ")\t czas: "
+            << elapsed_seconds.count() << "s\n";
+
+  start = std::chrono::system_clock::now();
+  {
+    const Tree<int, int> tree = Tree<int, int>::fromUnsorted(items.begin(), items.end());
+  }
+  elapsed_seconds = std::chrono::system_clock::now() - start;
+  std::cout << "\t budowa Drzewa przez fromUnsorted (" << repeatCount << ")\t czas: "
+            << elapsed_seconds.count() << "s\n";
+}
+
+// suma wartosci: zwykly iterator kontra parallelReduce na puli watkow
+template <template <typename, typename> class MapType>
+void perfomScanTest(std::size_t repeatCount, const char* name)
+{
+  MapType<int, int> map;
+  for (std::size_t i = 0; i < repeatCount; i++)
+    map[static_cast<int>(i)] = static_cast<int>(i % 1000);
+
+  std::chrono::time_point<std::chrono::system_clock> start = std::chrono::system_clock::now();
+  long long sum = 0;
+  for (const auto& item : map)
+    sum += item.second;
+  std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - start;
+  std::cout << "\t sumowanie iteratorem w " << name << " (" << sum << ")\t czas: " << elapsed_seconds.count() << "s\n";
+
+  start = std::chrono::system_clock::now();
+  sum = map.parallelReduce(0LL, [](const std::pair<const int, int>& item) { return static_cast<long long>(item.second); },
+                           [](long long left, long long right) { return left + right; });
+  elapsed_seconds = std::chrono::system_clock::now() - start;
+  std::cout << "\t sumowanie parallelReduce w " << name << " (" << sum << ", watki robocze: "
+            << aisdi::ThreadPool::instance().getWorkerCount() << ")\t czas: " << elapsed_seconds.count() << "s\n";
+}
+
+// bez rownowazenia rosnace klucze robily z drzewa liste i ten test trwal godzinami
+void perfomSequentialTreeTest(std::size_t repeatCount)
+{
+  Tree<int, std::string> tree;
+
+  std::chrono::time_point<std::chrono::system_clock> start = std::chrono::system_clock::now();
+  for (std::size_t i = 0; i < repeatCount; i++)
+    tree[static_cast<int>(i)] = "word";
+  std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - start;
+  std::cout << "dodawanie " << repeatCount << " rosnacych kluczy do Drzewa\t czas: " << elapsed_seconds.count() << "s\n";
+
+  {
+    Tree<int, std::string> hinted;
+    start = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < repeatCount; i++)
+      hinted.insert(hinted.end(), static_cast<int>(i), "word");
+    elapsed_seconds = std::chrono::system_clock::now() - start;
+    std::cout << "dodawanie " << repeatCount << " rosnacych kluczy z podpowiedzia end()\t czas: " << elapsed_seconds.count() << "s\n";
+  }
+
+  start = std::chrono::system_clock::now();
+  Tree<int, std::string> copy(tree);
+  elapsed_seconds = std::chrono::system_clock::now() - start;
+  std::cout << "kopiowanie Drzewa z " << copy.getSize() << " elementami\t czas: " << elapsed_seconds.count() << "s\n";
+
+  // przenoszenie przedzialow kluczy miedzy mapami, jak przy przesuwaniu granic shardow
+  start = std::chrono::system_clock::now();
+  const std::size_t splitCount = 10000;
+  for (std::size_t i = 0; i < splitCount; i++)
+  {
+    auto upper = copy.split(static_cast<int>(i * 7919 % repeatCount));
+    copy = Tree<int, std::string>::join(std::move(copy), std::move(upper));
+  }
+  elapsed_seconds = std::chrono::system_clock::now() - start;
+  std::cout << splitCount << " razy split i join Drzewa\t czas: " << elapsed_seconds.count() << "s\n";
+
+  start = std::chrono::system_clock::now();
+  for (std::size_t i = 0; i < repeatCount; i++)
+    tree.remove(static_cast<int>(i));
+  elapsed_seconds = std::chrono::system_clock::now() - start;
+  std::cout << "usuwanie " << repeatCount << " rosnacych kluczy z Drzewa\t czas: " << elapsed_seconds.count() << "s\n";
+}
 
 void perfomTest(std::size_t repeatCount, std::size_t tableSize)
 {
   (void)repeatCount;
-  (void)tableSize;
   std::chrono::time_point<std::chrono::system_clock> start, end;
   std::chrono::duration<double> elapsed_seconds;
 
-  Map<int, std::string> map;
+  Map<int, std::string> map(tableSize);
   Tree<int, std::string> tree;
 
   std::cout << "operacja przeprowadzona na:" << repeatCount << " elementow\n";
@@ -38,6 +354,13 @@ void perfomTest(std::size_t repeatCount, std::size_t tableSize)
     std::cout << "\t dodawanie elementow w Hashmapie (losowo klucze)\t czas: " << elapsed_seconds.count() << "s\n";
   }
 
+  perfomLookupTest<Map>(repeatCount, tableSize, "Hashmapie");
+  perfomLookupTest<SwissMap>(repeatCount, tableSize, "SwissHashMapie");
+  perfomLookupTest<RobinHoodMap>(repeatCount, tableSize, "RobinHoodHashMapie");
+  perfomConcurrentTest(repeatCount, tableSize);
+  perfomReadMostlyTest(repeatCount, tableSize);
+  perfomShardedTest(repeatCount);
+
   {
 
     start = std::chrono::system_clock::now();
@@ -47,7 +370,7 @@ void perfomTest(std::size_t repeatCount, std::size_t tableSize)
     elapsed_seconds = end - start;
     std::cout << "\t dodawanie elementow w Drzewie (losowo klucze)\t czas: " << elapsed_seconds.count() << "s\n";
   }
-/*
+
   {
 
     start = std::chrono::system_clock::now();
@@ -65,10 +388,8 @@ void perfomTest(std::size_t repeatCount, std::size_t tableSize)
       map[i]= "word";
     end = std::chrono::system_clock::now();
     elapsed_seconds = end - start;
-    std::cout << "\t dodawanie elementow w Drzewie (rosnace klucze)\t czas: " << elapsed_seconds.count() << "s\n";
+    std::cout << "\t dodawanie elementow w Hashmapie (rosnace klucze)\t czas: " << elapsed_seconds.count() << "s\n";
   }
-
-*/
 }
 
 } // namespace
@@ -79,5 +400,15 @@ int main(int argc, char** argv)
   const std::size_t tableSize   = argc > 2 ? std::atoll(argv[2]) : 100000;
   for (std::size_t i = 0; i < 5; ++i)
   perfomTest(repeatCount, tableSize);
+  perfomSequentialTreeTest(1000000);
+
+  const std::size_t orderedCount = argc > 3 ? std::atoll(argv[3]) : 1000000;
+  perfomOrderedTest<Tree>(orderedCount, "Drzewie");
+  perfomOrderedTest<BPlusTree>(orderedCount, "B+drzewie");
+  perfomOrderedTest<CompactTree>(orderedCount, "zwartym Drzewie");
+  perfomConcurrentOrderedTest(orderedCount);
+  perfomScanTest<Map>(orderedCount, "Hashmapie");
+  perfomScanTest<Tree>(orderedCount, "Drzewie");
+  perfomBulkLoadTest(orderedCount);
   return 0;
 }